@@ -0,0 +1,108 @@
+/** *************************************************************************************
+
+    * @file        abort.js
+    * @brief       AbortSignal helpers for cancellable bot actions
+    * @author      Agustín I. Galdeman
+    * @author      Ian A. Dib
+    * @author      Luciano S. Cordero
+    * @date        2025-07-17
+    * @version     1.0 - Initial cancellation helpers module
+
+    ************************************************************************************* */
+
+
+/* **************************************************************************************
+    * CLASS IMPLEMENTATIONS *
+   ************************************************************************************** */
+
+/**
+ * @class Abortable
+ * @brief Static helpers turning waits and long running promises into cancellable ones
+ * @details Every helper accepts a missing signal, in which case it behaves like the plain
+ *          operation. Cancellation always rejects with an Error named 'AbortError', so
+ *          callers can tell a preemption apart from a real failure with isAbort().
+ */
+class Abortable
+{
+    /**
+     * @brief Builds the error thrown when a signal fires
+     * @param {AbortSignal} signal - Aborted signal
+     * @returns {Error} Error named 'AbortError' carrying the abort reason
+     */
+    static error(signal)
+    {
+        const reason = signal && signal.reason;
+        const error = new Error(reason instanceof Error ? reason.message : (reason || 'Action aborted'));
+        error.name = 'AbortError';
+        return error;
+    }
+
+    /**
+     * @brief Throws if a signal has already fired
+     * @param {AbortSignal} signal - Signal to check (optional)
+     * @throws {Error} AbortError if the signal is aborted
+     */
+    static check(signal)
+    {
+        if (signal && signal.aborted) throw Abortable.error(signal);
+    }
+
+    /**
+     * @brief Checks whether an error comes from a cancelled action
+     * @param {Error} error - Caught error
+     * @returns {boolean} True for AbortError
+     */
+    static isAbort(error)
+    {
+        return !!error && error.name === 'AbortError';
+    }
+
+    /**
+     * @brief Waits for a duration, waking up early when the signal fires
+     * @param {number} ms - Duration in milliseconds
+     * @param {AbortSignal} signal - Cancellation signal (optional)
+     * @returns {Promise} Resolves after the duration
+     * @throws {Error} AbortError if the signal fires first
+     */
+    static sleep(ms, signal = null)
+    {
+        return Abortable.race(new Promise(resolve => setTimeout(resolve, ms)), signal);
+    }
+
+    /**
+     * @brief Races a promise against a signal, running a cleanup when the signal wins
+     * @param {Promise} promise - Operation to wait for
+     * @param {AbortSignal} signal - Cancellation signal (optional)
+     * @param {Function} onAbort - Cleanup run once on cancellation, e.g. stopDigging (optional)
+     * @returns {Promise} Result of the operation
+     * @throws {Error} AbortError if the signal fires first
+     */
+    static race(promise, signal = null, onAbort = null)
+    {
+        if (!signal) return promise;
+
+        if (signal.aborted)
+        {
+            if (onAbort) onAbort();
+            promise.catch(() => {});
+            return Promise.reject(Abortable.error(signal));
+        }
+
+        return new Promise((resolve, reject) =>
+        {
+            const abort = () =>
+            {
+                if (onAbort) onAbort();
+                reject(Abortable.error(signal));
+            };
+
+            signal.addEventListener('abort', abort, { once: true });
+
+            promise.then(
+                (value) => { signal.removeEventListener('abort', abort); resolve(value); },
+                (error) => { signal.removeEventListener('abort', abort); reject(error); });
+        });
+    }
+}
+
+module.exports = Abortable;
@@ -18,16 +18,21 @@
 const { GoalBlock } = require('mineflayer-pathfinder').goals;
 const { Vec3 } = require("vec3");
 
+const Abortable = require('./abort');
+const ChatScheduler = require('./chat');
+const TransferPlanner = require('./transfer');
+const ToolSelector = require('./tools');
+
 
 /* **************************************************************************************
     * CONSTANTS AND STATIC DATA *
    ************************************************************************************** */
 
-// Direction mappings with movement offsets and yaw rotations
+// Direction mappings with movement offsets and yaw rotations (Mineflayer convention, north = 0)
 const DIRECTION_MAPPINGS =
 {
-    north: {x: 0, z: -1, yaw: Math.PI},
-    south: {x: 0, z: 1, yaw: 0},
+    north: {x: 0, z: -1, yaw: 0},
+    south: {x: 0, z: 1, yaw: Math.PI},
     west: {x: -1, z: 0, yaw: Math.PI/2},
     east: {x: 1, z: 0, yaw: -Math.PI/2}
 };
@@ -38,6 +43,42 @@ const DEFAULT_SEARCH_DISTANCE = 16;
 // Jump control duration in milliseconds
 const JUMP_DURATION = 500;
 
+// Rotation change in radians below which a look packet is not worth sending
+const LOOK_THRESHOLD = 0.05;
+
+// Longest wait for a sprint jump to land, in milliseconds
+const SPRINT_JUMP_TIMEOUT = 1500;
+
+// Duration of one swim or climb stroke in milliseconds
+const STROKE_DURATION = 300;
+
+// Longest wait for a climb to gain or lose one block, in milliseconds
+const CLIMB_TIMEOUT = 1500;
+
+// Longest wait for a pillar jump to clear the placement cell, in milliseconds
+const PILLAR_TIMEOUT = 1000;
+
+// Foods never picked automatically because of their side effects
+const UNSAFE_FOODS = new Set(['rotten_flesh', 'spider_eye', 'poisonous_potato', 'pufferfish', 'chorus_fruit', 'suspicious_stew']);
+
+// Faces tried, in order, when looking for a block to place against
+const PLACE_FACES = [
+    {x: 0, y: -1, z: 0}, {x: 1, y: 0, z: 0}, {x: -1, y: 0, z: 0},
+    {x: 0, y: 0, z: 1}, {x: 0, y: 0, z: -1}, {x: 0, y: 1, z: 0}
+];
+
+// Player eye height above the feet in blocks
+const EYE_HEIGHT = 1.62;
+
+// Maximum distance from the eyes to a block centre for interaction
+const INTERACTION_REACH = 4.5;
+
+// Default maximum number of blocks returned by multi-block searches
+const DEFAULT_SEARCH_COUNT = 32;
+
+// Blocks without collision that still must not be walked into
+const HAZARD_BLOCKS = new Set(['lava', 'fire', 'soul_fire', 'cobweb', 'sweet_berry_bush', 'powder_snow']);
+
 
 /* **************************************************************************************
     * CLASS IMPLEMENTATIONS *
@@ -52,11 +93,31 @@ class BotActions
     /**
      * @brief Constructor initializes the bot actions system
      * @param {Object} bot - Mineflayer bot instance
+     * @param {Object} inventory - InventoryIndex instance for item queries (optional)
+     * @param {Object} containers - ContainerMemory instance recording opened chests (optional)
+     * @param {Object} blocks - BlockIndex instance for ore, log and container lookups (optional)
+     * @param {Object} entities - EntityGrid instance for nearby entity queries (optional)
      */
-    constructor(bot)
+    constructor(bot, inventory = null, containers = null, blocks = null, entities = null)
     {
         this.bot = bot;
+        this.inventory = inventory;
+        this.containers = containers;
+        this.blocks = blocks;
+        this.entities = entities;
+        this.transfer = new TransferPlanner(bot);
+        this.tools = new ToolSelector(bot, inventory);
+        this.chatScheduler = new ChatScheduler(bot);
         this.chestWindow = null; // Keep reference to open chest
+        this.lookStats = { sent: 0, skipped: 0 };
+    }
+
+    /**
+     * @brief Forgets the window state of a lost connection
+     */
+    reattach()
+    {
+        this.chestWindow = null;
     }
 
     //* MOVEMENT AND NAVIGATION
@@ -64,47 +125,55 @@ class BotActions
     /**
      * @brief Executes a single step movement in a cardinal direction
      * @param {string} direction - Cardinal direction (north, south, east, west)
+     * @param {boolean} sprint - Hold sprint during the step (default: false)
+     * @param {Object} options - { signal } AbortSignal cancelling the action (optional)
      * @returns {boolean} True if movement succeeded, false otherwise
-     * @throws {Error} If invalid direction is provided
+     * @throws {Error} If invalid direction is provided, or AbortError when cancelled
      */
-    async step(direction)
+    async step(direction, sprint = false, { signal } = {})
     {
         if (!DIRECTION_MAPPINGS[direction]) throw new Error(`Invalid direction: ${direction}`);
 
-        const offset = DIRECTION_MAPPINGS[direction];
-        
         try
         {
-            // Set bot orientation using lookAt with a target point
-            const currentPos = this.bot.entity.position;
-            const targetPoint = new Vec3(
-                currentPos.x + offset.x,
-                currentPos.y,
-                currentPos.z + offset.z
-            );
-            
-            await this.bot.lookAt(targetPoint, true);
+            Abortable.check(signal);
+
+            // Face the direction; the rotation goes out with the first movement packet
+            await this.lookAt(direction, true, true);
             
             // Move forward with direct control, as pathfinder.goto() caused errors
+            this.bot.setControlState('sprint', sprint);
             this.bot.setControlState('forward', true);
             
             // Movement duration - adjust as needed
-            await new Promise(resolve => setTimeout(resolve, 300));
+            await Abortable.sleep(300, signal);
             
             // Stop movement
             this.bot.setControlState('forward', false);
+            this.bot.setControlState('sprint', false);
             
             return true;
         }
         catch (error)
         {
-            // Ensure movement is stopped even on error
-            console.log('step error')
+            // Ensure movement is stopped even on error or cancellation
+            if (!Abortable.isAbort(error)) console.log('step error');
             this.bot.setControlState('forward', false);
+            this.bot.setControlState('sprint', false);
             throw error;
         }
     }
 
+    /**
+     * @brief Releases every movement control and stops any dig in progress
+     * @details Used when a running action is preempted from outside its own call.
+     */
+    halt()
+    {
+        this.bot.clearControlStates();
+        if (this.bot.targetDigBlock) this.bot.stopDigging();
+    }
+
     /**
      * @brief Executes a jump action with timed control state management
      * @returns {boolean} Always returns true after jump execution
@@ -119,32 +188,299 @@ class BotActions
         return true;
     }
 
+    /**
+     * @brief Sprint-jumps across a gap in a cardinal direction and waits for the landing
+     * @details Sprint, forward and jump are held from the take-off until the bot touches
+     *          the ground again after leaving it, or until SPRINT_JUMP_TIMEOUT expires.
+     * @param {string} direction - Cardinal direction (north, south, east, west)
+     * @param {Object} options - { signal } AbortSignal cancelling the action (optional)
+     * @returns {boolean} True if the bot landed within the timeout
+     * @throws {Error} If invalid direction is provided, or AbortError when cancelled
+     */
+    async sprintJump(direction, { signal } = {})
+    {
+        if (!DIRECTION_MAPPINGS[direction]) throw new Error(`Invalid direction: ${direction}`);
+
+        try
+        {
+            await this.lookAt(direction, true, true);
+
+            this.bot.setControlState('sprint', true);
+            this.bot.setControlState('forward', true);
+            this.bot.setControlState('jump', true);
+
+            // Wait for the bot to leave the ground, then to touch it again
+            const deadline = Date.now() + SPRINT_JUMP_TIMEOUT;
+            let airborne = false;
+            while (Date.now() < deadline)
+            {
+                await Abortable.sleep(50, signal);
+
+                if (!this.bot.entity.onGround)
+                {
+                    airborne = true;
+                    this.bot.setControlState('jump', false);
+                }
+                else if (airborne)
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+        finally
+        {
+            this.bot.setControlState('jump', false);
+            this.bot.setControlState('forward', false);
+            this.bot.setControlState('sprint', false);
+        }
+    }
+
+    /**
+     * @brief Swims one stroke in a cardinal direction
+     * @details Holding jump in water rises, holding sneak sinks and neither keeps the
+     *          bot level. Rising against a shore block also lifts the bot out of the water.
+     * @param {string} direction - Cardinal direction (north, south, east, west)
+     * @param {string} vertical - 'up', 'down' or 'level' (default: 'level')
+     * @param {Object} options - { signal } AbortSignal cancelling the action (optional)
+     * @returns {boolean} True after the stroke
+     * @throws {Error} If invalid direction is provided, or AbortError when cancelled
+     */
+    async swim(direction, vertical = 'level', { signal } = {})
+    {
+        if (!DIRECTION_MAPPINGS[direction]) throw new Error(`Invalid direction: ${direction}`);
+
+        try
+        {
+            await this.lookAt(direction);
+
+            this.bot.setControlState('forward', true);
+            this.bot.setControlState('jump', vertical === 'up');
+            this.bot.setControlState('sneak', vertical === 'down');
+
+            await Abortable.sleep(STROKE_DURATION, signal);
+            return true;
+        }
+        finally
+        {
+            this.bot.setControlState('forward', false);
+            this.bot.setControlState('jump', false);
+            this.bot.setControlState('sneak', false);
+        }
+    }
+
+    /**
+     * @brief Climbs one block up or down the ladder or vine the bot is in
+     * @details Climbing up holds jump while pressing into the climbable; climbing down
+     *          releases every control and lets the bot slide.
+     * @param {string} direction - Cardinal direction the bot faces while climbing
+     * @param {boolean} up - Climb up (true) or down (false)
+     * @param {Object} options - { signal } AbortSignal cancelling the action (optional)
+     * @returns {boolean} True if the bot moved one block within the timeout
+     * @throws {Error} If invalid direction is provided, or AbortError when cancelled
+     */
+    async climb(direction, up = true, { signal } = {})
+    {
+        if (!DIRECTION_MAPPINGS[direction]) throw new Error(`Invalid direction: ${direction}`);
+
+        const startY = Math.floor(this.bot.entity.position.y);
+        const targetY = up ? startY + 1 : startY - 1;
+
+        try
+        {
+            await this.lookAt(direction);
+
+            this.bot.setControlState('forward', up);
+            this.bot.setControlState('jump', up);
+
+            const deadline = Date.now() + CLIMB_TIMEOUT;
+            while (Date.now() < deadline)
+            {
+                await Abortable.sleep(50, signal);
+
+                const y = Math.floor(this.bot.entity.position.y);
+                if (up ? y >= targetY : y <= targetY) return true;
+            }
+
+            return false;
+        }
+        finally
+        {
+            this.bot.setControlState('forward', false);
+            this.bot.setControlState('jump', false);
+        }
+    }
+
+    /**
+     * @brief Opens a door, gate or trapdoor in front and steps through without stopping
+     * @details Forward is held before the block is activated, so the bot keeps walking
+     *          while the open packet goes out and reaches the block as it swings open.
+     * @param {string} direction - Cardinal direction (north, south, east, west)
+     * @param {Object} door - Position of the block to open with x, y, z
+     * @param {Object} options - { signal } AbortSignal cancelling the action (optional)
+     * @returns {boolean} True if movement succeeded, false if the block is gone
+     * @throws {Error} If invalid direction is provided, or AbortError when cancelled
+     */
+    async openAndStep(direction, door, { signal } = {})
+    {
+        if (!DIRECTION_MAPPINGS[direction]) throw new Error(`Invalid direction: ${direction}`);
+
+        const block = this.bot.blockAt(new Vec3(door.x, door.y, door.z));
+        if (!block) return false;
+
+        try
+        {
+            Abortable.check(signal);
+            this.bot.setControlState('forward', true);
+            await Abortable.race(this.bot.activateBlock(block), signal);
+        }
+        catch (error)
+        {
+            this.bot.setControlState('forward', false);
+            throw error;
+        }
+
+        return this.step(direction, false, { signal });
+    }
+
+    /**
+     * @brief Places a building block over the gap in front and walks onto it
+     * @details The bot sneaks so it cannot fall off the edge, keeps pressing forward
+     *          while the block is placed against the side of its own floor block and
+     *          walks on as soon as the server confirms the placement.
+     * @param {string} direction - Cardinal direction (north, south, east, west)
+     * @param {Object} options - { signal } AbortSignal cancelling the action (optional)
+     * @returns {boolean} True if the block was placed and the step taken
+     * @throws {Error} If invalid direction is provided, no building block is available,
+     *         or AbortError when cancelled
+     */
+    async bridge(direction, { signal } = {})
+    {
+        if (!DIRECTION_MAPPINGS[direction]) throw new Error(`Invalid direction: ${direction}`);
+
+        const offset = DIRECTION_MAPPINGS[direction];
+        const pos = this.position();
+        const floor = this.bot.blockAt(new Vec3(pos.x, pos.y - 1, pos.z));
+        if (!floor || floor.boundingBox !== 'block') return false;
+
+        await this.equipBuildingBlock();
+
+        try
+        {
+            Abortable.check(signal);
+            this.bot.setControlState('sneak', true);
+            this.bot.setControlState('forward', true);
+            await Abortable.race(this.bot.placeBlock(floor, new Vec3(offset.x, 0, offset.z)), signal);
+            this.bot.setControlState('forward', false);
+
+            return await this.step(direction, false, { signal });
+        }
+        finally
+        {
+            this.bot.setControlState('forward', false);
+            this.bot.setControlState('sneak', false);
+        }
+    }
+
+    /**
+     * @brief Jumps and places a building block under the feet, rising one block
+     * @param {Object} options - { signal } AbortSignal cancelling the action (optional)
+     * @returns {boolean} True if the block was placed
+     * @throws {Error} If no building block is available, or AbortError when cancelled
+     */
+    async pillar({ signal } = {})
+    {
+        const pos = this.position();
+        const floor = this.bot.blockAt(new Vec3(pos.x, pos.y - 1, pos.z));
+        if (!floor || floor.boundingBox !== 'block') return false;
+
+        await this.equipBuildingBlock();
+        await this.look(this.bot.entity.yaw, -Math.PI / 2);
+
+        try
+        {
+            this.bot.setControlState('jump', true);
+
+            // Place once the feet have cleared the cell the block goes into
+            const deadline = Date.now() + PILLAR_TIMEOUT;
+            while (this.bot.entity.position.y < pos.y + 1)
+            {
+                if (Date.now() >= deadline) return false;
+                await Abortable.sleep(25, signal);
+            }
+
+            await Abortable.race(this.bot.placeBlock(floor, new Vec3(0, 1, 0)), signal);
+            return true;
+        }
+        finally
+        {
+            this.bot.setControlState('jump', false);
+        }
+    }
+
     //* VIEW AND ORIENTATION CONTROL
 
     /**
      * @brief Adjusts bot's viewing direction to look at a specific cardinal direction
      * @param {string} direction - Cardinal direction (north, south, east, west)
      * @param {boolean} force - Force immediate look without smooth transition
+     * @param {boolean} merge - Send the rotation with the next position packet (default: false)
      * @returns {boolean} Always returns true after look completion
      */
-    async lookAt(direction, force = true)
+    async lookAt(direction, force = true, merge = false)
     {
         if (!DIRECTION_MAPPINGS[direction]) throw new Error(`Invalid direction: ${direction}`);
         
-        const offset = DIRECTION_MAPPINGS[direction];
-        const currentPos = this.bot.entity.position;
-
-        // Convert direction to Vec3
-        const targetPoint = new Vec3(
-            currentPos.x + offset.x,
-            currentPos.y,
-            currentPos.z + offset.z
-        );
-        
-        await this.bot.lookAt(targetPoint, force);
+        await this.look(DIRECTION_MAPPINGS[direction].yaw, 0, force, merge);
         return true;
     }
 
+    /**
+     * @brief Rotates the bot, skipping rotations it is already facing
+     * @details The target is compared with the head's actual rotation, which digging,
+     *          placing, activating and server corrections also change; a difference
+     *          smaller than LOOK_THRESHOLD sends nothing. With merge the look is not
+     *          awaited, so a movement started right after goes out in the same position
+     *          and look packet.
+     * @param {number} yaw - Yaw in radians
+     * @param {number} pitch - Pitch in radians
+     * @param {boolean} force - Force immediate look without smooth transition (default: true)
+     * @param {boolean} merge - Send the rotation with the next position packet (default: false)
+     * @returns {boolean} True if a rotation was commanded, false if it was skipped
+     */
+    async look(yaw, pitch, force = true, merge = false)
+    {
+        const entity = this.bot.entity;
+        if (Math.abs(BotActions.angleDelta(yaw, entity.yaw)) < LOOK_THRESHOLD &&
+            Math.abs(pitch - entity.pitch) < LOOK_THRESHOLD)
+        {
+            this.lookStats.skipped++;
+            return false;
+        }
+
+        this.lookStats.sent++;
+
+        const looking = this.bot.look(yaw, pitch, force);
+        if (merge) looking.catch(() => {});
+        else await looking;
+        return true;
+    }
+
+    /**
+     * @brief Signed difference between two angles, wrapped to [-PI, PI]
+     * @param {number} a - Angle in radians
+     * @param {number} b - Angle in radians
+     * @returns {number} Difference a - b in radians
+     */
+    static angleDelta(a, b)
+    {
+        const delta = (a - b) % (2 * Math.PI);
+        if (delta > Math.PI) return delta - 2 * Math.PI;
+        if (delta < -Math.PI) return delta + 2 * Math.PI;
+        return delta;
+    }
+
     //* POSITION AND WORLD QUERIES
 
     /**
@@ -161,6 +497,61 @@ class BotActions
         };
     }
 
+    /**
+     * @brief Counts the blocks available for bridging and pillaring
+     * @returns {number} Number of items tagged 'building' in the inventory
+     */
+    buildingBlocks()
+    {
+        return this.inventory ? this.inventory.countTag('building') : 0;
+    }
+
+    /**
+     * @brief Retrieves the remaining air while underwater
+     * @returns {number} Oxygen level from 0 to 20 (20 when not submerged)
+     */
+    oxygenLevel()
+    {
+        return this.bot.oxygenLevel ?? 20;
+    }
+
+    /**
+     * @brief Picks the most nourishing safe food in the inventory
+     * @returns {Object|null} Inventory item, or null when there is nothing to eat
+     */
+    bestFood()
+    {
+        const foods = this.bot.registry.foodsByName;
+        const names = this.inventory ? this.inventory.byName.keys() : this.bot.inventory.items().map(item => item.name);
+
+        let best = null;
+        for (const name of names)
+        {
+            const food = foods[name];
+            if (!food || UNSAFE_FOODS.has(name)) continue;
+            if (!best || food.effectiveQuality > best.effectiveQuality) best = food;
+        }
+
+        if (!best) return null;
+        if (!this.inventory) return this.bot.inventory.items().find(item => item.name === best.name);
+
+        const [slot] = this.inventory.slotsOf(best.name);
+        return this.inventory.itemAt(slot);
+    }
+
+    /**
+     * @brief Holds a food item and eats it
+     * @param {Object} item - Inventory item to eat
+     * @param {Object} options - { signal } AbortSignal cancelling the action (optional)
+     * @throws {Error} AbortError when cancelled, which also stops eating
+     */
+    async eat(item, { signal } = {})
+    {
+        Abortable.check(signal);
+        await this.bot.equip(item, 'hand');
+        await Abortable.race(this.bot.consume(), signal, () => this.bot.deactivateItem());
+    }
+
     /**
      * @brief Retrieves spawn point coordinates
      * @returns {Object|null} Spawn point coordinates or null if not available
@@ -206,6 +597,62 @@ class BotActions
         return null;
     }
 
+    /**
+     * @brief Locates every block of specified type within search radius
+     * @param {string} blockType - Name of the block type to search for
+     * @param {number} maxDistance - Maximum search distance (default: 16)
+     * @param {number} count - Maximum number of blocks returned (default: 32)
+     * @returns {Array} Block positions with x, y, z, nearest first
+     */
+    find_blocks(blockType, maxDistance = DEFAULT_SEARCH_DISTANCE, count = DEFAULT_SEARCH_COUNT)
+    {
+        const positions = this.bot.findBlocks
+        ({
+            matching: (block) => block.name === blockType,
+            maxDistance: maxDistance,
+            count: count
+        });
+
+        return positions.map(pos => ({ x: pos.x, y: pos.y, z: pos.z, name: blockType }));
+    }
+
+    /**
+     * @brief Checks whether a block is within interaction reach of the bot's eyes
+     * @param {number} x - X coordinate
+     * @param {number} y - Y coordinate
+     * @param {number} z - Z coordinate
+     * @param {number} reach - Maximum distance in blocks (default: 4.5)
+     * @returns {boolean} True if the block centre is within reach
+     */
+    canReach(x, y, z, reach = INTERACTION_REACH)
+    {
+        const eye = this.bot.entity.position.offset(0, EYE_HEIGHT, 0);
+        return eye.distanceTo(new Vec3(x + 0.5, y + 0.5, z + 0.5)) <= reach;
+    }
+
+    /**
+     * @brief Checks whether the bot can move through a block
+     * @details Shared by navigation and stand planning: grass, flowers, torches, snow
+     *          layers and water have no collision box and are walked through, while
+     *          collision-free hazards such as lava and cobwebs are not.
+     * @param {Object} block - Block, or the object returned by block_at
+     * @returns {boolean} True if the block has no collision box and is harmless
+     */
+    isPassable(block)
+    {
+        return block.boundingBox === 'empty' && !HAZARD_BLOCKS.has(block.name);
+    }
+
+    /**
+     * @brief Checks whether a block harms the bot when walked into or landed on
+     * @param {Object} block - Block, or the object returned by block_at
+     * @returns {boolean} True for lava, fire, cobwebs and similar blocks
+     */
+    isHazard(block)
+    {
+        return HAZARD_BLOCKS.has(block.name);
+    }
+
     /**
      * @brief Retrieves block information at specific world coordinates
      * @param {number} x - X coordinate
@@ -228,6 +675,21 @@ class BotActions
         return null;
     }
 
+    /**
+     * @brief Reads the state properties of a block, e.g. a door's open and facing
+     * @details Kept out of block_at, which runs several times per movement cycle, since
+     *          decoding the properties allocates an object per call.
+     * @param {number} x - X coordinate
+     * @param {number} y - Y coordinate
+     * @param {number} z - Z coordinate
+     * @returns {Object} Property name to value, empty if the block is not loaded
+     */
+    blockState(x, y, z)
+    {
+        const block = this.bot.blockAt(new Vec3(x, y, z));
+        return block && block.getProperties ? block.getProperties() : {};
+    }
+
     //* WORLD INTERACTION COMMANDS
 
     /**
@@ -235,10 +697,11 @@ class BotActions
      * @param {number} x - X coordinate of the chest
      * @param {number} y - Y coordinate of the chest
      * @param {number} z - Z coordinate of the chest
+     * @param {Object} options - { signal } AbortSignal cancelling the action (optional)
      * @returns {boolean} True if chest opened successfully
-     * @throws {Error} If block is not found or cannot be opened as chest
+     * @throws {Error} If block is not found or cannot be opened as chest, or AbortError when cancelled
      */
-    async openChestAt(x, y, z)
+    async openChestAt(x, y, z, { signal } = {})
     {
         const block = this.bot.blockAt(new Vec3(x, y, z));
         
@@ -247,13 +710,21 @@ class BotActions
             throw new Error("Block not found at specified coordinates");
         }
 
+        Abortable.check(signal);
+        const opening = this.bot.openChest(block);
+
+        // A window that opens after cancellation is closed straight away
+        const closeLate = () => opening.then(window => window.close(), () => {});
+
         try
         {
-            this.chestWindow = await this.bot.openChest(block);
+            this.chestWindow = await Abortable.race(opening, signal, closeLate);
+            if (this.containers) this.containers.watch(block, this.chestWindow);
             return true;
         }
         catch (error)
         {
+            if (Abortable.isAbort(error)) throw error;
             throw new Error(`Failed to open chest: ${error.message}`);
         }
     }
@@ -277,6 +748,43 @@ class BotActions
         }));
     }
 
+    /**
+     * @brief Moves items between the open chest and the inventory with a planned click batch
+     * @param {Object} delta - Item name to amount; positive withdraws, negative deposits
+     * @param {Object} options - Planner options, e.g. { hotbar: { itemName: hotbarIndex } },
+     *                          plus an optional pipeline depth and AbortSignal as signal
+     * @returns {Object} Number of clicks sent and per item shortfall
+     * @throws {Error} If no chest is currently open, or AbortError when cancelled
+     */
+    async transferItems(delta, options = {})
+    {
+        if (!this.chestWindow)
+        {
+            throw new Error("No chest is currently open");
+        }
+
+        Abortable.check(options.signal);
+        const plan = this.transfer.plan(this.chestWindow, delta, options);
+        const clicks = await this.transfer.execute(plan.clicks, options.depth, options.signal);
+        return { clicks, shortfall: plan.shortfall };
+    }
+
+    /**
+     * @brief Withdraws everything the open chest holds, as far as the inventory allows
+     * @param {Object} options - { signal } AbortSignal cancelling the action (optional)
+     * @returns {Object} Number of clicks sent and per item shortfall
+     * @throws {Error} If no chest is currently open, or AbortError when cancelled
+     */
+    async emptyChest({ signal } = {})
+    {
+        const delta = {};
+        for (const item of this.getChestContents())
+        {
+            delta[item.name] = (delta[item.name] || 0) + item.count;
+        }
+        return this.transferItems(delta, { signal });
+    }
+
     /**
      * @brief Closes the currently open chest
      * @returns {boolean} True if chest was closed successfully
@@ -289,19 +797,69 @@ class BotActions
             throw new Error("No chest is currently open");
         }
 
+        if (this.containers) this.containers.unwatch(this.chestWindow);
         this.chestWindow.close();
         this.chestWindow = null;
         return true;
     }
 
     /**
-     * @brief Sends a message to the game chat
+     * @brief Places a building block at specified coordinates
+     * @param {number} x - X coordinate of the cell to fill
+     * @param {number} y - Y coordinate of the cell to fill
+     * @param {number} z - Z coordinate of the cell to fill
+     * @param {Object} options - { signal } AbortSignal cancelling the action (optional)
+     * @returns {boolean} True if the block was placed
+     * @throws {Error} If there is no block to place against or no building block,
+     *         or AbortError when cancelled
+     */
+    async placeBlock(x, y, z, { signal } = {})
+    {
+        for (const face of PLACE_FACES)
+        {
+            const reference = this.bot.blockAt(new Vec3(x + face.x, y + face.y, z + face.z));
+            if (!reference || reference.boundingBox !== 'block') continue;
+
+            Abortable.check(signal);
+            await this.equipBuildingBlock();
+            await Abortable.race(this.bot.placeBlock(reference, new Vec3(-face.x, -face.y, -face.z)), signal);
+            return true;
+        }
+
+        throw new Error("No adjacent block to place against");
+    }
+
+    /**
+     * @brief Equips a building block from the inventory
+     * @returns {boolean} True once a building block is held
+     * @throws {Error} If the inventory holds no building blocks
+     */
+    async equipBuildingBlock()
+    {
+        const held = this.bot.heldItem;
+        if (held && this.inventory && this.inventory.tagsOf(held.name).includes('building')) return true;
+
+        const slots = this.inventory ? this.inventory.slotsOfTag('building') : new Set();
+        for (const slot of slots)
+        {
+            const item = this.inventory.itemAt(slot);
+            if (!item) continue;
+
+            await this.bot.equip(item, 'hand');
+            return true;
+        }
+
+        throw new Error("No building blocks in inventory");
+    }
+
+    /**
+     * @brief Sends a message to the game chat through the rate limited scheduler
      * @param {string} message - Message to send to chat
-     * @returns {boolean} Always returns true after sending message
+     * @returns {boolean} Always returns true after queueing the message
      */
     chat(message)
     {
-        this.bot.chat(message);
+        this.chatScheduler.send(message);
         return true;
     }
 
@@ -310,10 +868,11 @@ class BotActions
      * @param {number} x - X coordinate of the block to dig
      * @param {number} y - Y coordinate of the block to dig
      * @param {number} z - Z coordinate of the block to dig
+     * @param {Object} options - { signal } AbortSignal cancelling the action (optional)
      * @returns {boolean} True if block was successfully dug
-     * @throws {Error} If block cannot be dug or is not found
+     * @throws {Error} If block cannot be dug or is not found, or AbortError when cancelled
      */
-    async dig_block(x, y, z)
+    async dig_block(x, y, z, { signal } = {})
     {
         const blockToDig = this.bot.blockAt(new Vec3(x, y, z));
 
@@ -329,14 +888,58 @@ class BotActions
 
         try
         {
-            await this.bot.dig(blockToDig);
+            Abortable.check(signal);
+            await this.tools.equipFor(blockToDig);
+            await Abortable.race(this.bot.dig(blockToDig), signal, () => this.bot.stopDigging());
+            this.tools.recordDig();
             return true;
         }
         catch (error)
         {
+            if (Abortable.isAbort(error)) throw error;
             throw new Error(`Failed to dig block: ${error.message}`);
         }
     }
+
+    /**
+     * @brief Digs several blocks in the order and with the tools minimising total time
+     * @param {Array} positions - Block positions with x, y, z
+     * @param {boolean} ordered - Keep the given order, e.g. when blocks depend on each other
+     * @param {Object} options - { signal } AbortSignal cancelling the action (optional)
+     * @returns {number} Number of blocks dug
+     * @throws {Error} AbortError when cancelled
+     */
+    async dig_blocks(positions, ordered = false, { signal } = {})
+    {
+        const blocks = [];
+        for (const pos of positions)
+        {
+            const block = this.bot.blockAt(new Vec3(pos.x, pos.y, pos.z));
+            if (block && block.name !== 'air' && this.bot.canDigBlock(block)) blocks.push(block);
+        }
+
+        const plan = this.tools.schedule(blocks, ordered);
+        let dug = 0;
+
+        for (const step of plan.steps)
+        {
+            try
+            {
+                Abortable.check(signal);
+                await this.tools.equip(step.item);
+                await Abortable.race(this.bot.dig(step.block), signal, () => this.bot.stopDigging());
+                this.tools.recordDig();
+                dug++;
+            }
+            catch (error)
+            {
+                if (Abortable.isAbort(error)) throw error;
+                console.log(`Dig skipped at (${step.block.position.x}, ${step.block.position.y}, ${step.block.position.z}): ${error.message}`);
+            }
+        }
+
+        return dug;
+    }
 }
 
 module.exports = BotActions;
\ No newline at end of file
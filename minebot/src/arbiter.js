@@ -0,0 +1,148 @@
+/** *************************************************************************************
+
+    * @file        arbiter.js
+    * @brief       Utility arbiter choosing between survival, maintenance and mission branches
+    * @author      Agustín I. Galdeman
+    * @author      Ian A. Dib
+    * @author      Luciano S. Cordero
+    * @date        2025-07-23
+    * @version     1.0 - Initial behavior arbiter module
+
+    ************************************************************************************* */
+
+
+/* **************************************************************************************
+    * CONSTANTS AND STATIC DATA *
+   ************************************************************************************** */
+
+// Score lead a branch needs over the running one to interrupt it mid-action
+const PREEMPT_MARGIN = 0.25;
+
+
+/* **************************************************************************************
+    * CLASS IMPLEMENTATIONS *
+   ************************************************************************************** */
+
+/**
+ * @class BehaviorArbiter
+ * @brief Runs the highest scoring behavior branch each tick, rescoring only dirty branches
+ * @details A branch declares the events its score depends on. Those events only mark the
+ *          branch dirty; its score function runs again at the next tick, or right away
+ *          while another branch is running so an urgent concern can preempt it. Branches
+ *          whose inputs did not fire keep their cached score, so idle concerns cost
+ *          nothing per tick. Ties go to the branch added first.
+ */
+class BehaviorArbiter
+{
+    /**
+     * @brief Constructor initializes an arbiter without branches
+     * @param {Function} preempt - Called with a reason to cancel the running action
+     */
+    constructor(preempt)
+    {
+        this.preempt = preempt;
+        this.branches = [];
+        this.running = null;
+        this.subscriptions = [];    // { emitter, event, listener }
+        this.stats = { ticks: 0, evaluations: 0, preemptions: 0 };
+    }
+
+    //* BRANCHES
+
+    /**
+     * @brief Adds a branch
+     * @param {string} name - Branch name shown in logs
+     * @param {Array} inputs - [emitter, event] pairs that invalidate the score
+     * @param {Function} score - () => number, utility of running the branch now
+     * @param {Function} run - () => Promise, one step of the branch
+     */
+    addBranch(name, inputs, score, run)
+    {
+        const branch = { name, score, run, value: 0, dirty: true };
+        this.branches.push(branch);
+
+        for (const [emitter, event] of inputs)
+        {
+            const listener = () => this.invalidate(branch);
+            emitter.on(event, listener);
+            this.subscriptions.push({ emitter, event, listener });
+        }
+    }
+
+    /**
+     * @brief Marks a branch dirty, preempting the running branch if it is now outscored
+     * @param {Object} branch - Branch whose inputs changed
+     */
+    invalidate(branch)
+    {
+        branch.dirty = true;
+        if (!this.running || this.running === branch) return;
+
+        if (this.evaluate(branch) > this.running.value + PREEMPT_MARGIN)
+        {
+            this.stats.preemptions++;
+            this.preempt(`${branch.name} preempts ${this.running.name}`);
+        }
+    }
+
+    /**
+     * @brief Refreshes a branch score if its inputs changed
+     * @param {Object} branch - Branch to score
+     * @returns {number} Current score
+     */
+    evaluate(branch)
+    {
+        if (branch.dirty)
+        {
+            branch.value = branch.score();
+            branch.dirty = false;
+            this.stats.evaluations++;
+        }
+
+        return branch.value;
+    }
+
+    //* EXECUTION
+
+    /**
+     * @brief Runs one step of the best branch
+     * @details The winner is marked dirty afterwards, since its own step usually changes
+     *          the inputs it is scored on.
+     * @returns {Promise} Resolves when the step is done
+     */
+    async tick()
+    {
+        this.stats.ticks++;
+
+        let best = null;
+        for (const branch of this.branches)
+        {
+            const value = this.evaluate(branch);
+            if (!best || value > best.value) best = branch;
+        }
+
+        if (!best) return;
+
+        this.running = best;
+        try
+        {
+            await best.run();
+        }
+        finally
+        {
+            this.running = null;
+            best.dirty = true;
+        }
+    }
+
+    /**
+     * @brief Unsubscribes every branch input
+     */
+    detach()
+    {
+        for (const { emitter, event, listener } of this.subscriptions) emitter.removeListener(event, listener);
+        this.subscriptions = [];
+    }
+}
+
+module.exports = BehaviorArbiter;
@@ -15,7 +15,17 @@
     * INCLUDES AND DEPENDENCIES *
    ************************************************************************************** */
 
+const Abortable = require('./abort');
+const ActionQueue = require('./queue');
 const SimplePathfinder = require('./pathfinder');
+const MoveSimulator = require('./movesim');
+const StorageRun = require('./storage');
+const MiningEngine = require('./mining');
+const TreeHarvester = require('./harvest');
+const DropCollector = require('./collector');
+const Mission = require('./mission');
+const BehaviorArbiter = require('./arbiter');
+const VitalsMonitor = require('./vitals');
 
 
 /* **************************************************************************************
@@ -25,14 +35,39 @@ const SimplePathfinder = require('./pathfinder');
 // Initial wait before starting autonomous behavior
 const INITIAL_WAIT = 3000;
 
+// Wait before resuming after a reconnect, letting the nearby chunks arrive
+const RESUME_WAIT = 1000;
+
 // Movement execution interval in milliseconds
 const MOVEMENT_INTERVAL = 200;
 
-// Goal coordinates sequence
-const GOAL_SEQUENCE = [
-    { x: -640, y: 71, z: 128, type: 'chest_location' },
-    { x: -791, y: 103, z: 152, type: 'final_destination' }
-];
+// Most actions the queue runs at the same time
+const MAX_IN_FLIGHT = 2;
+
+// Resources locked by walking, building and world interaction actions; every one of them
+// turns the head, so all lock 'look' and none races a queued rotation
+const MOVE_RESOURCES = ['movement', 'look'];
+const BUILD_RESOURCES = ['movement', 'look', 'hand'];
+const WORK_RESOURCES = ['movement', 'look', 'hand', 'window'];
+
+// Resources locked by each survival remedy
+const REMEDY_RESOURCES = { eat: ['hand'], surface: MOVE_RESOURCES, retreat: MOVE_RESOURCES };
+
+// Arbiter scores: the mission runs unless a concern outranks it; survival is scored
+// by the vitals monitor's remedy urgency
+const MISSION_SCORE = 0.5;
+const MAINTENANCE_SCORE = 0.6;
+
+// Cached move outcomes carried over in a checkpoint
+const CHECKPOINT_CACHE_SIZE = 1024;
+
+// Search radius and limit for containers visited by a storage run
+const STORAGE_SEARCH_RADIUS = 32;
+const STORAGE_SEARCH_COUNT = 16;
+
+// Events reported by state handlers and the non-state transition targets
+const EVENTS = Mission.EVENTS;
+const { NEXT_GOAL, RESUME } = Mission.TARGETS;
 
 
 /* **************************************************************************************
@@ -42,6 +77,9 @@ const GOAL_SEQUENCE = [
 /**
  * @class AutonomousBot
  * @brief State machine for autonomous movement using pathfinder for navigation
+ * @details States, goals and transitions come from a compiled mission file. Each state
+ *          handler performs one step and reports an event; the mission table maps it to
+ *          the next state, so adding a mission never requires editing this class.
  */
 class AutonomousBot
 {
@@ -49,23 +87,51 @@ class AutonomousBot
      * @brief Constructor initializes and starts autonomous behavior
      * @param {Object} bot - Mineflayer bot instance
      * @param {Object} actions - BotActions instance for movement control
+     * @param {string} missionFile - Mission JSON path (default: missions/default.json)
      */
-    constructor(bot, actions)
+    constructor(bot, actions, missionFile = null)
     {
         this.bot = bot;
         this.actions = actions;
-        this.pathfinder = new SimplePathfinder(actions);
-        this.currentState = 'MOVING_TO_CHEST_AREA';
+        this.simulator = new MoveSimulator(bot);
+        this.pathfinder = new SimplePathfinder(actions, actions.entities, this.simulator);
+        this.mission = Mission.load(missionFile, this);
+        this.stateCode = 0;
+        this.stateEntry = 0;        // Bumped on every state change, invalidates stale events
+        this.stateEnteredAt = Date.now();
+        this.attempts = 0;          // Failures absorbed by the current state's retries
         this.isRunning = false;
+        this.loopActive = false;
+        this.abortController = new AbortController(); // Cancels the running action on preempt()
+        this.queue = new ActionQueue({ maxInFlight: MAX_IN_FLIGHT });
+        this.turnAction = null;     // Queue id of the last rotation queued by changeDirection
         
         // Goal management
+        this.goals = this.mission.goals.map(goal => Object.assign({}, goal));
         this.currentGoalIndex = 0;
-        this.currentGoal = GOAL_SEQUENCE[0];
+        this.currentGoal = null;
         this.chestCoordinates = null;
         this.collectedItems = [];
         
-        // Set initial goal
-        this.pathfinder.setGoal(this.currentGoal.x, this.currentGoal.y, this.currentGoal.z);
+        // Mining management
+        this.collector = new DropCollector(bot, actions);
+        this.mining = new MiningEngine(bot, actions, actions.blocks, this.collector);
+        this.miningMode = 'vein';
+        this.miningOptions = {};
+        this.harvester = new TreeHarvester(bot, actions, actions.blocks, this.mining);
+        this.harvestOptions = {};
+        
+        // Storage run management
+        this.storageRun = null;
+        this.resumeState = null;
+        this.resumeGoal = null;     // Pathfinder goal of the interrupted state, e.g. the chest
+        
+        // Survival, maintenance and mission branches competing for each tick
+        this.vitals = new VitalsMonitor(bot, actions);
+        this.arbiter = this.buildArbiter();
+        
+        // Enter the state handling the first goal
+        this.enterGoal();
         
         // Start autonomous behavior after initial wait
         setTimeout(() => this.start(), INITIAL_WAIT);
@@ -81,8 +147,8 @@ class AutonomousBot
         this.isRunning = true;
         console.log(`Starting autonomous behavior - Goal: (${this.currentGoal.x}, ${this.currentGoal.y}, ${this.currentGoal.z})`);
         
-        // Begin continuous movement loop
-        this.movementLoop();
+        // Begin continuous movement loop, unless a stopped loop is still finishing its cycle
+        if (!this.loopActive) this.movementLoop();
     }
 
     /**
@@ -90,72 +156,220 @@ class AutonomousBot
      */
     async movementLoop()
     {
+        this.loopActive = true;
+
         while (this.isRunning)
         {
+            // A preempted cycle leaves an aborted controller behind
+            if (this.abortController.signal.aborted) this.abortController = new AbortController();
+
             try
             {
-                // Execute state machine
-                await this.executeStateMachine();
+                // Run the best scoring branch; the mission branch executes the state machine
+                await this.arbiter.tick();
                 
                 // Wait before next cycle
                 await this.sleep(MOVEMENT_INTERVAL);
             }
             catch (error)
             {
+                if (Abortable.isAbort(error))
+                {
+                    console.log(`Action preempted: ${error.message}`);
+                    continue;
+                }
+
                 console.log(`Movement error: ${error.message}`);
                 await this.sleep(MOVEMENT_INTERVAL);
             }
         }
+
+        this.loopActive = false;
+    }
+
+    //* ARBITRATION
+
+    /**
+     * @brief Builds the arbiter with its survival, maintenance and mission branches
+     * @details Survival is rescored when the vitals monitor names a new remedy, maintenance
+     *          on item entities appearing or vanishing; the mission score is constant.
+     * @returns {BehaviorArbiter} Arbiter preempting this bot's actions
+     */
+    buildArbiter()
+    {
+        const arbiter = new BehaviorArbiter((reason) => this.preempt(reason));
+
+        arbiter.addBranch('survival', [[this.vitals, 'change']], () => this.vitals.urgency, () => this.runRemedy());
+
+        arbiter.addBranch('maintenance', [[this.bot, 'entitySpawn'], [this.bot, 'entityGone']],
+            () => (this.collector.pendingCount() > 0 ? MAINTENANCE_SCORE : 0), () => this.collectDrops());
+
+        arbiter.addBranch('mission', [], () => MISSION_SCORE, () => this.executeStateMachine());
+        return arbiter;
+    }
+
+    /**
+     * @brief Runs the remedy the vitals monitor asks for
+     * @details Remedies run beside the state machine rather than as states, so the mission
+     *          state, goal, sub-mode and resume slot are untouched and the preempted state
+     *          handler is entered again on the next mission tick. Handlers that do long
+     *          work continue from the progress they kept (see startMining).
+     */
+    async runRemedy()
+    {
+        const remedy = this.vitals.remedy;
+        if (!remedy) return;
+
+        console.log(`Survival: ${remedy} (health ${this.bot.health}, food ${this.bot.food}, oxygen ${this.actions.oxygenLevel()})`);
+        await this.perform(remedy, REMEDY_RESOURCES[remedy], (signal) =>
+            this.vitals[remedy](signal), ActionQueue.PRIORITIES.urgent);
+        this.vitals.refresh();
+    }
+
+    /**
+     * @brief Picks up the drops the collector is tracking
+     */
+    async collectDrops()
+    {
+        const result = await this.perform('collect_drops', MOVE_RESOURCES, (signal) =>
+            this.collector.collect({ signal }));
+        console.log(`Collected ${result.collected} drops, ${result.left} left behind`);
     }
 
+    //* STATE MACHINE
+
     /**
-     * @brief Executes state machine logic
+     * @brief Runs the current state's handler and follows the transition for its event
+     * @details States flagged 'chain' run in the same tick they are entered. An event is
+     *          dropped if the state changed while its handler was running, e.g. after a
+     *          command redirected the bot.
      */
     async executeStateMachine()
     {
-        switch (this.currentState)
+        do
         {
-            case 'MOVING_TO_CHEST_AREA':
-                await this.handleMovingToChestArea();
-                break;
-                
-            case 'SEARCHING_CHEST':
-                await this.handleSearchingChest();
-                break;
-                
-            case 'MOVING_TO_CHEST':
-                await this.handleMovingToChest();
-                break;
-                
-            case 'MANAGING_CHEST':
-                await this.handleManagingChest();
-                break;
-                
-            case 'MOVING_TO_FINAL':
-                await this.handleMovingToFinal();
-                break;
-                
-            case 'MINING':
-                await this.handleMining();
-                break;
-                
-            case 'COMPLETED':
-                console.log('All tasks completed!');
-                this.stop();
-                break;
+            const code = this.stateCode;
+            const entry = this.stateEntry;
+            const event = this.hasTimedOut() ? EVENTS.timeout : await this.mission.handlers[code]();
+
+            if (event === undefined || entry !== this.stateEntry) return;
+            this.transition(code, event);
+        }
+        while (this.isRunning && this.mission.chain[this.stateCode]);
+    }
+
+    //* STATE TRANSITIONS
+
+    /**
+     * @brief Applies the mission transition for an event
+     * @param {number} code - State that reported the event
+     * @param {number} event - Event code
+     */
+    transition(code, event)
+    {
+        if (event === EVENTS.failed && this.attempts < this.mission.retries[code])
+        {
+            this.attempts++;
+            console.log(`${this.currentState} failed, retry ${this.attempts}/${this.mission.retries[code]}`);
+            return;
         }
+
+        const target = this.mission.next(code, event);
+        if (target === NEXT_GOAL) this.advanceGoal();
+        else if (target === RESUME) this.resume();
+        else if (target >= 0) this.enterState(target);
     }
 
+    /**
+     * @brief Makes a state current, resetting its timeout and retry count
+     * @param {number} code - State index
+     */
+    enterState(code)
+    {
+        this.stateCode = code;
+        this.stateEntry++;
+        this.stateEnteredAt = Date.now();
+        this.attempts = 0;
+    }
+
+    /**
+     * @brief Enters a sub-mode, remembering the interrupted state and where it was heading
+     * @details Re-entering the sub-mode it is already in keeps the original resume slot.
+     * @param {number} code - Sub-mode state index
+     */
+    suspendFor(code)
+    {
+        if (this.stateCode !== code)
+        {
+            const goal = this.pathfinder.goal;
+            this.resumeState = this.stateCode;
+            this.resumeGoal = goal ? { x: goal.x, y: goal.y, z: goal.z } : null;
+        }
+        this.enterState(code);
+    }
+
+    /**
+     * @brief Returns from a sub-mode to the interrupted state, or to the current goal
+     */
+    resume()
+    {
+        const state = this.resumeState;
+        this.resumeState = null;
+
+        if (state === null)
+        {
+            if (this.currentGoalIndex < this.goals.length) this.enterGoal();
+            else this.enterState(this.mission.final);
+            return;
+        }
+
+        this.enterState(state);
+        this.restoreResumeGoal();
+    }
+
+    /**
+     * @brief Points the pathfinder back at the interrupted state's goal
+     * @details The interrupted state may have been heading elsewhere than the current
+     *          goal, e.g. MOVING_TO_CHEST walks to the chest found inside the goal area.
+     */
+    restoreResumeGoal()
+    {
+        const goal = this.resumeGoal || this.currentGoal;
+        this.resumeGoal = null;
+        if (goal) this.pathfinder.setGoal(goal.x, goal.y, goal.z);
+    }
+
+    /**
+     * @brief Checks whether the current state has run past its mission timeout
+     * @returns {boolean} True if a timeout is set and elapsed
+     */
+    hasTimedOut()
+    {
+        const timeout = this.mission.timeouts[this.stateCode];
+        return timeout > 0 && Date.now() - this.stateEnteredAt > timeout;
+    }
+
+    /**
+     * @brief Name of the current state, for logs, commands and telemetry
+     * @returns {string} State name
+     */
+    get currentState()
+    {
+        return this.mission.names[this.stateCode];
+    }
+
+    //* STATE HANDLERS
+
     /**
      * @brief Handles movement to chest area
+     * @returns {number|undefined} 'reached' once in the chest area
      */
     async handleMovingToChestArea()
     {
         if (this.pathfinder.hasReachedGoal())
         {
-            console.log('Reached chest area, searching for chest...');
-            this.currentState = 'SEARCHING_CHEST';
-            return;
+            console.log(`Reached chest area (travel cost ${this.pathfinder.travelCost}), searching for chest...`);
+            return EVENTS.reached;
         }
 
         // Execute pathfinder movement
@@ -165,6 +379,7 @@ class AutonomousBot
 
     /**
      * @brief Handles chest searching
+     * @returns {number|undefined} 'found' once a chest is located
      */
     async handleSearchingChest()
     {
@@ -178,7 +393,7 @@ class AutonomousBot
             
             // Set new goal to chest coordinates
             this.pathfinder.setGoal(chest.x, chest.y, chest.z);
-            this.currentState = 'MOVING_TO_CHEST';
+            return EVENTS.found;
         }
         else
         {
@@ -191,14 +406,21 @@ class AutonomousBot
 
     /**
      * @brief Handles movement to chest
+     * @returns {number|undefined} 'reached' once the chest is in reach
      */
     async handleMovingToChest()
     {
+        const chest = this.chestCoordinates;
+        if (this.actions.canReach(chest.x, chest.y, chest.z))
+        {
+            console.log('Chest in reach, starting chest management...');
+            return EVENTS.reached;
+        }
+
         if (this.pathfinder.hasReachedGoal())
         {
             console.log('Reached chest, starting chest management...');
-            this.currentState = 'MANAGING_CHEST';
-            return;
+            return EVENTS.reached;
         }
 
         // Execute pathfinder movement
@@ -208,6 +430,7 @@ class AutonomousBot
 
     /**
      * @brief Handles chest management (open, collect, close, report)
+     * @returns {number} 'done', or 'failed' if the chest could not be emptied
      */
     async handleManagingChest()
     {
@@ -215,7 +438,9 @@ class AutonomousBot
         {
             // Open chest
             console.log('Opening chest...');
-            await this.actions.openChestAt(this.chestCoordinates.x, this.chestCoordinates.y, this.chestCoordinates.z);
+            const chest = this.chestCoordinates;
+            await this.perform('open_chest', WORK_RESOURCES, (signal) =>
+                this.actions.openChestAt(chest.x, chest.y, chest.z, { signal }), ActionQueue.PRIORITIES.interaction);
             
             // Get chest contents
             const contents = this.actions.getChestContents();
@@ -224,6 +449,11 @@ class AutonomousBot
             // Store collected items for reporting
             this.collectedItems = contents.map(item => `${item.count}x ${item.name}`);
             
+            // Withdraw everything with one planned click batch
+            const transfer = await this.perform('empty_chest', WORK_RESOURCES, (signal) =>
+                this.actions.emptyChest({ signal }), ActionQueue.PRIORITIES.interaction);
+            console.log(`Emptied chest with ${transfer.clicks} clicks`);
+            
             // Close chest
             this.actions.closeChest();
             console.log('Chest closed');
@@ -239,51 +469,200 @@ class AutonomousBot
                 this.actions.chat('Chest was empty');
             }
             
-            // Move to next goal
-            this.currentGoalIndex++;
-            if (this.currentGoalIndex < GOAL_SEQUENCE.length)
-            {
-                this.currentGoal = GOAL_SEQUENCE[this.currentGoalIndex];
-                this.pathfinder.setGoal(this.currentGoal.x, this.currentGoal.y, this.currentGoal.z);
-                this.currentState = 'MOVING_TO_FINAL';
-                console.log(`Moving to final destination: (${this.currentGoal.x}, ${this.currentGoal.y}, ${this.currentGoal.z})`);
-            }
-            else
-            {
-                this.currentState = 'COMPLETED';
-            }
+            return EVENTS.done;
         }
         catch (error)
         {
+            // A preempted chest stays the current target
+            if (Abortable.isAbort(error))
+            {
+                if (this.actions.chestWindow) this.actions.closeChest();
+                throw error;
+            }
+
             console.log(`Chest management error: ${error.message}`);
             this.actions.chat(`Error managing chest: ${error.message}`);
-            
-            // Move to next goal anyway
-            this.currentGoalIndex++;
-            if (this.currentGoalIndex < GOAL_SEQUENCE.length)
+            return EVENTS.failed;
+        }
+    }
+
+    /**
+     * @brief Starts a storage run over several containers, resuming the current state after
+     * @param {Array|null} containers - Container positions, or null to search nearby chests
+     * @param {Object} options - Optional { collect: boolean } to withdraw the contents
+     * @returns {number} Number of containers queued
+     */
+    startStorageRun(containers = null, options = {})
+    {
+        const targets = containers || this.actions.find_blocks('chest', STORAGE_SEARCH_RADIUS, STORAGE_SEARCH_COUNT);
+        if (targets.length === 0) return 0;
+
+        const start = this.actions.position();
+        this.storageRun = new StorageRun(start, targets, (from, to) => this.pathfinder.estimateCost(from, to), options);
+
+        this.suspendFor(this.mission.code('STORAGE_RUN'));
+
+        const first = this.storageRun.current();
+        this.pathfinder.setGoal(first.x, first.y, first.z);
+        console.log(`Storage run started over ${targets.length} containers`);
+        return targets.length;
+    }
+
+    /**
+     * @brief Handles a storage run: opens each container as soon as it is in reach and
+     *        starts walking to the next one in the same cycle it closes the current one
+     * @returns {number|undefined} 'done' once every container was visited
+     */
+    async handleStorageRun()
+    {
+        const run = this.storageRun;
+        const target = run.current();
+
+        if (!target)
+        {
+            this.finishStorageRun();
+            return EVENTS.done;
+        }
+
+        if (this.actions.canReach(target.x, target.y, target.z))
+        {
+            try
             {
-                this.currentGoal = GOAL_SEQUENCE[this.currentGoalIndex];
-                this.pathfinder.setGoal(this.currentGoal.x, this.currentGoal.y, this.currentGoal.z);
-                this.currentState = 'MOVING_TO_FINAL';
+                await this.perform('open_chest', WORK_RESOURCES, (signal) =>
+                    this.actions.openChestAt(target.x, target.y, target.z, { signal }), ActionQueue.PRIORITIES.interaction);
+                const contents = this.actions.getChestContents();
+                if (run.collect)
+                {
+                    await this.perform('empty_chest', WORK_RESOURCES, (signal) =>
+                        this.actions.emptyChest({ signal }), ActionQueue.PRIORITIES.interaction);
+                }
+                run.record(target, contents);
             }
-            else
+            catch (error)
             {
-                this.currentState = 'COMPLETED';
+                if (Abortable.isAbort(error))
+                {
+                    if (this.actions.chestWindow) this.actions.closeChest();
+                    throw error;
+                }
+
+                console.log(`Storage run error at (${target.x}, ${target.y}, ${target.z}): ${error.message}`);
+                run.record(target, null);
+            }
+
+            // Closing only sends a packet, so the walk to the next container starts right away
+            if (this.actions.chestWindow) this.actions.closeChest();
+            run.advance();
+
+            const next = run.current();
+            if (!next)
+            {
+                this.finishStorageRun();
+                return EVENTS.done;
             }
+            this.pathfinder.setGoal(next.x, next.y, next.z);
+        }
+
+        const movement = this.pathfinder.getNextMovement();
+        await this.executeMovement(movement);
+    }
+
+    /**
+     * @brief Reports a finished storage run
+     */
+    finishStorageRun()
+    {
+        const summary = this.storageRun.summary();
+        console.log(`Storage run done: ${summary.visited} containers, ${summary.failed} failed, ${summary.msPerContainer} ms each`);
+        this.actions.chat(`Storage run: ${summary.visited} containers, ${summary.items} items`);
+
+        this.storageRun = null;
+    }
+
+    //* GOAL MANAGEMENT
+
+    /**
+     * @brief Moves on to the next goal in the list, or completes when none is left
+     */
+    advanceGoal()
+    {
+        this.currentGoalIndex++;
+        if (this.currentGoalIndex < this.goals.length)
+        {
+            this.enterGoal();
+        }
+        else
+        {
+            this.enterState(this.mission.final);
         }
     }
 
+    /**
+     * @brief Makes the goal at the current index active and picks the state that handles it
+     */
+    enterGoal()
+    {
+        this.currentGoal = this.goals[this.currentGoalIndex];
+        this.pathfinder.setGoal(this.currentGoal.x, this.currentGoal.y, this.currentGoal.z);
+        this.enterState(this.mission.entry(this.currentGoal.type));
+        console.log(`Moving to ${this.currentGoal.type}: (${this.currentGoal.x}, ${this.currentGoal.y}, ${this.currentGoal.z})`);
+    }
+
+    /**
+     * @brief Sends the bot to a position right away, resuming the goal list afterwards
+     * @param {number} x - Target X coordinate
+     * @param {number} y - Target Y coordinate
+     * @param {number} z - Target Z coordinate
+     */
+    gotoPosition(x, y, z)
+    {
+        const index = Math.min(this.currentGoalIndex, this.goals.length);
+        this.goals.splice(index, 0, { x, y, z, type: 'waypoint' });
+        this.currentGoalIndex = index;
+        this.redirect('goto');
+    }
+
+    /**
+     * @brief Replaces the current goal, or appends one when the list is finished
+     * @param {Object} goal - Goal with x, y, z and type
+     */
+    replaceGoal(goal)
+    {
+        const index = Math.min(this.currentGoalIndex, this.goals.length);
+        this.goals[index] = goal;
+        this.currentGoalIndex = index;
+        this.redirect('new goal');
+    }
+
+    /**
+     * @brief Abandons the running task and sub-mode and heads for the current goal
+     * @param {string} reason - Preemption reason shown in the log
+     */
+    redirect(reason)
+    {
+        this.preempt(reason);
+        this.storageRun = null;
+        this.resumeState = null;
+        this.resumeGoal = null;
+        this.enterGoal();
+        this.start();
+    }
+
     /**
      * @brief Handles movement to final destination
+     * @returns {number|undefined} 'reached' once at the goal
      */
     async handleMovingToFinal()
     {
         if (this.pathfinder.hasReachedGoal())
         {
-            console.log('Reached final destination!');
-            this.actions.chat('Reached final destination!');
-            this.currentState = 'COMPLETED';
-            return;
+            const goal = this.currentGoal;
+            const message = goal.type === 'waypoint' ?
+                `Reached waypoint (${goal.x}, ${goal.y}, ${goal.z})` : 'Reached final destination!';
+
+            console.log(message);
+            this.actions.chat(message);
+            return EVENTS.reached;
         }
 
         // Execute pathfinder movement
@@ -292,31 +671,165 @@ class AutonomousBot
     }
 
     /**
-     * @brief Handles mining operations
+     * @brief Switches to mining, returning to the current state when done
+     * @details The origin is pinned and the progress object kept in the mining options,
+     *          so a run preempted by a remedy or saved in a checkpoint continues its
+     *          tunnel or quarry instead of laying out a new one where the bot now stands.
+     * @param {string} mode - Mining mode (vein, strip, branch, quarry)
+     * @param {Object} options - Mode parameters
+     */
+    startMining(mode = 'vein', options = {})
+    {
+        this.miningMode = mode;
+        this.miningOptions = Object.assign({}, options, {
+            origin: this.actions.position(),
+            progress: { done: 0, blocks: 0, ores: 0 }
+        });
+
+        this.suspendFor(this.mission.code('MINING'));
+    }
+
+    /**
+     * @brief Handles mining operations through the mining engine
+     * @returns {number} 'done', or 'failed' on a mining error
      */
     async handleMining()
     {
-        // Example logic, not implemented in the states machine flow
         try
         {
-            const pos = this.actions.position();
-            const blockBelow = this.actions.block_at(pos.x, pos.y - 1, pos.z);
-            
-            if (blockBelow && blockBelow.name !== 'air' && blockBelow.name !== 'bedrock')
-            {
-                console.log(`Mining block: ${blockBelow.name}`);
-                await this.actions.dig_block(pos.x, pos.y - 1, pos.z);
-                this.actions.chat(`Mined: ${blockBelow.name}`);
-            }
-            
-            // Continue with other states
-            this.currentState = 'MOVING_TO_FINAL';
+            const report = await this.perform('mining', WORK_RESOURCES, (signal) =>
+                this.mining.run(this.miningMode, Object.assign({}, this.miningOptions, { signal })));
+            console.log(`Mining ${report.mode} done: ${report.blocks} blocks, ${report.ores} ores in ${report.seconds}s`);
+            this.actions.chat(`Mined ${report.ores} ores (${report.oresPerMinute.toFixed(1)} ores/min)`);
+            return EVENTS.done;
         }
         catch (error)
         {
+            // Preempted mining continues from its saved progress on the next cycle
+            if (Abortable.isAbort(error)) throw error;
             console.log(`Mining error: ${error.message}`);
-            this.currentState = 'MOVING_TO_FINAL';
+            return EVENTS.failed;
+        }
+    }
+
+    /**
+     * @brief Switches to tree harvesting, returning to the current state when done
+     * @param {Object} options - { trees, radius, naive }
+     */
+    startHarvesting(options = {})
+    {
+        this.harvestOptions = options;
+
+        this.suspendFor(this.mission.code('HARVESTING'));
+    }
+
+    /**
+     * @brief Handles tree harvesting through the tree harvester
+     * @returns {number} 'done', or 'failed' on a harvest error
+     */
+    async handleHarvesting()
+    {
+        try
+        {
+            const report = await this.perform('harvesting', WORK_RESOURCES, (signal) =>
+                this.harvester.run(Object.assign({}, this.harvestOptions, { signal })));
+            console.log(`Harvest (${report.mode}) done: ${report.logs} logs from ${report.trees} trees in ${report.seconds}s`);
+            this.actions.chat(`Harvested ${report.logs} logs (${report.logsPerMinute.toFixed(1)} logs/min)`);
+            return EVENTS.done;
+        }
+        catch (error)
+        {
+            if (Abortable.isAbort(error)) throw error;
+            console.log(`Harvest error: ${error.message}`);
+            return EVENTS.failed;
+        }
+    }
+
+    /**
+     * @brief Handles the final state: reports and stops the loop
+     */
+    handleCompleted()
+    {
+        console.log('All tasks completed!');
+        this.stop();
+    }
+
+    //* CHECKPOINTING
+
+    /**
+     * @brief Compact snapshot of mission progress and planner caches
+     * @returns {Object} JSON-safe snapshot for the checkpoint store
+     */
+    checkpoint()
+    {
+        return {
+            mission: this.mission.name,
+            missionHash: this.mission.hash,
+            state: this.currentState,
+            resume: this.resumeState === null ? null : this.mission.names[this.resumeState],
+            resumeGoal: this.resumeGoal,
+            goalIndex: this.currentGoalIndex,
+            goals: this.goals,
+            chest: this.chestCoordinates,
+            collected: this.collectedItems,
+            mining: { mode: this.miningMode, options: this.miningOptions },
+            harvest: this.harvestOptions,
+            pathfinder: {
+                goal: this.pathfinder.goal,
+                direction: this.pathfinder.getDirection(),
+                travelCost: this.pathfinder.travelCost
+            },
+            moves: this.simulator.exportCache(CHECKPOINT_CACHE_SIZE)
+        };
+    }
+
+    /**
+     * @brief Resumes mission progress from a checkpoint
+     * @details A storage run in progress is not saved, so it resumes at the state it
+     *          interrupted, heading for that state's goal as resume() would rather than
+     *          the container the run was walking to. Checkpoints of a completed mission, or of another mission or
+     *          another version of this one (their state and goal indexes may not match),
+     *          are ignored.
+     * @param {Object} data - Snapshot written by checkpoint()
+     * @returns {boolean} True if progress was restored
+     * @throws {Error} If the checkpoint names a state the mission does not have
+     */
+    restore(data)
+    {
+        if (!data || data.missionHash !== this.mission.hash) return false;
+
+        const inStorageRun = data.state === 'STORAGE_RUN';
+        const state = this.mission.code(inStorageRun ? data.resume : data.state);
+        if (state === this.mission.final) return false;
+
+        this.goals = data.goals;
+        this.currentGoalIndex = data.goalIndex;
+        this.currentGoal = this.goals[this.currentGoalIndex] || null;
+        this.chestCoordinates = data.chest;
+        this.collectedItems = data.collected;
+        this.miningMode = data.mining.mode;
+        this.miningOptions = data.mining.options;
+        this.harvestOptions = data.harvest;
+
+        this.enterState(state);
+        this.resumeState = inStorageRun || data.resume === null ? null : this.mission.code(data.resume);
+        this.resumeGoal = data.resumeGoal || null;
+
+        if (inStorageRun)
+        {
+            this.restoreResumeGoal();
         }
+        else if (data.pathfinder.goal)
+        {
+            const goal = data.pathfinder.goal;
+            this.pathfinder.setGoal(goal.x, goal.y, goal.z);
+        }
+        this.pathfinder.setDirection(data.pathfinder.direction);
+        this.pathfinder.travelCost = data.pathfinder.travelCost;
+        this.simulator.importCache(data.moves);
+
+        console.log(`Resumed ${this.mission.name} at ${this.currentState}, goal ${this.currentGoalIndex + 1}/${this.goals.length}`);
+        return true;
     }
 
     /**
@@ -328,25 +841,69 @@ class AutonomousBot
         switch (movement.action)
         {
             case 'change_direction':
-                await this.changeDirection(movement.newDirection);
+                this.changeDirection(movement.newDirection);
                 break;
                 
             case 'jump_and_move':
-                this.actions.jump();
-                await this.actions.step(movement.direction);
+                await this.perform('jump_and_move', MOVE_RESOURCES, (signal) =>
+                {
+                    this.actions.jump();
+                    return this.actions.step(movement.direction, movement.sprint, { signal });
+                });
                 break;
                 
             case 'move':
-                await this.actions.step(movement.direction);
+                await this.perform('move', MOVE_RESOURCES, (signal) =>
+                    this.actions.step(movement.direction, false, { signal }));
+                break;
+
+            case 'open_and_move':
+                await this.perform('open_and_move', MOVE_RESOURCES, (signal) =>
+                    this.actions.openAndStep(movement.direction, movement.door, { signal }));
+                break;
+
+            case 'bridge':
+                await this.perform('bridge', BUILD_RESOURCES, (signal) =>
+                    this.actions.bridge(movement.direction, { signal }));
+                break;
+
+            case 'pillar':
+                await this.perform('pillar', BUILD_RESOURCES, (signal) =>
+                    this.actions.pillar({ signal }));
+                break;
+
+            case 'swim':
+                await this.perform('swim', MOVE_RESOURCES, (signal) =>
+                    this.actions.swim(movement.direction, movement.vertical, { signal }));
+                break;
+
+            case 'climb':
+                await this.perform('climb', MOVE_RESOURCES, (signal) =>
+                    this.actions.climb(movement.direction, movement.up, { signal }));
+                break;
+
+            case 'sprint_jump':
+                if (!await this.perform('sprint_jump', MOVE_RESOURCES, (signal) =>
+                    this.actions.sprintJump(movement.direction, { signal })))
+                {
+                    console.log(`Sprint jump of ${movement.distance} blocks did not land`);
+                }
+                break;
+                
+            case 'wait':
+                await Abortable.sleep(movement.duration, this.signal());
                 break;
         }
     }
 
     /**
      * @brief Changes bot direction to specified new direction
+     * @details The rotation is queued without waiting for it: the next cycle plans while
+     *          the bot turns, and its move, which locks 'look', starts after the rotation
+     *          and is dropped with it if the rotation fails.
      * @param {string} newDirection - Direction to change to
      */
-    async changeDirection(newDirection)
+    changeDirection(newDirection)
     {
         const currentDirection = this.pathfinder.getDirection();
         
@@ -356,7 +913,61 @@ class AutonomousBot
         this.pathfinder.setDirection(newDirection);
         
         // Update bot's look direction
-        await this.actions.lookAt(newDirection);
+        const turn = this.queue.submit(() => this.actions.lookAt(newDirection),
+            { label: 'look', resources: ['look'], priority: ActionQueue.PRIORITIES.movement, signal: this.signal() });
+        this.turnAction = turn.id;
+        turn.promise.catch(error => { if (!Abortable.isAbort(error)) console.log(`Look error: ${error.message}`); });
+    }
+
+    /**
+     * @brief Runs an action through the action queue with the current cycle's signal
+     * @details Actions that turn the head depend on the rotation queued by changeDirection
+     *          while it is still active.
+     * @param {string} label - Action name used in queue errors
+     * @param {Array<string>} resources - Resources the action locks
+     * @param {Function} body - Action body (signal) => Promise
+     * @param {number} priority - Queue priority (default: movement)
+     * @returns {Promise} Result of the action
+     */
+    perform(label, resources, body, priority = ActionQueue.PRIORITIES.movement)
+    {
+        const after = resources.includes('look') && this.turnAction !== null ? [this.turnAction] : [];
+        return this.queue.run(body, { label, resources, priority, after, signal: this.signal() });
+    }
+
+    /**
+     * @brief Cancels the running action so the next cycle can act on a new decision
+     * @details Every primitive started with the current signal rejects with an AbortError,
+     *          releasing its controls; halt() also covers actions started without one.
+     * @param {string} reason - Why the action is preempted, shown in the log
+     */
+    preempt(reason = 'preempted')
+    {
+        this.abortController.abort(reason);
+        this.queue.clear(reason);
+        this.actions.halt();
+    }
+
+    /**
+     * @brief Signal of the current cycle, passed to every action started in it
+     * @returns {AbortSignal} Cancellation signal
+     */
+    signal()
+    {
+        return this.abortController.signal;
+    }
+
+    /**
+     * @brief Resynchronizes with a new connection and resumes where the lost one stopped
+     * @details Goals, mission state, the compiled mission and planner caches stay in
+     *          memory; only state tied to the old world is refreshed.
+     */
+    reattach()
+    {
+        this.simulator.reattach();
+        this.collector.reattach();
+        this.vitals.reattach();
+        setTimeout(() => this.start(), RESUME_WAIT);
     }
 
     /**
@@ -365,6 +976,7 @@ class AutonomousBot
     stop()
     {
         this.isRunning = false;
+        this.preempt('stopped');
         console.log('Stopping autonomous movement');
     }
 
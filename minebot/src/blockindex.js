@@ -0,0 +1,365 @@
+/** *************************************************************************************
+
+    * @file        blockindex.js
+    * @brief       Incremental index of interesting block types (ores, logs, containers)
+    * @author      Agustín I. Galdeman
+    * @author      Ian A. Dib
+    * @author      Luciano S. Cordero
+    * @date        2025-07-09
+    * @version     1.0 - Initial block index module
+
+    ************************************************************************************* */
+
+
+/* **************************************************************************************
+    * INCLUDES AND DEPENDENCIES *
+   ************************************************************************************** */
+
+const { Vec3 } = require('vec3');
+
+
+/* **************************************************************************************
+    * CONSTANTS AND STATIC DATA *
+   ************************************************************************************** */
+
+// Block name suffixes tracked by default
+const TRACKED_SUFFIXES = ['_ore', '_log', '_wood'];
+
+// Exact block names tracked by default; nether stems are listed because pumpkin, melon
+// and mushroom stems share their suffix
+const TRACKED_NAMES = [
+    'ancient_debris', 'chest', 'trapped_chest', 'barrel',
+    'crimson_stem', 'warped_stem', 'stripped_crimson_stem', 'stripped_warped_stem',
+    'crimson_hyphae', 'warped_hyphae', 'stripped_crimson_hyphae', 'stripped_warped_hyphae'
+];
+
+// Radius of the area scanned when the index needs (re)seeding
+const SEED_RADIUS = 64;
+
+// Maximum number of blocks collected by a single seeding scan
+const SEED_LIMIT = 4096;
+
+// Side of a chunk section in blocks
+const SECTION_SIZE = 16;
+
+
+/* **************************************************************************************
+    * CLASS IMPLEMENTATIONS *
+   ************************************************************************************** */
+
+/**
+ * @class BlockIndex
+ * @brief Position sets per tracked block type, kept exact through world events
+ * @details A palette-accelerated findBlocks scan seeds the index around the bot. From
+ *          then on block updates add and remove positions, chunks loading inside the seeded
+ *          sphere are scanned and unloaded chunks drop theirs, so queries only touch
+ *          matching positions. A query outside the seeded sphere triggers a new scan
+ *          around the query point.
+ */
+class BlockIndex
+{
+    /**
+     * @brief Constructor resolves tracked block ids and subscribes to world events
+     * @param {Object} bot - Mineflayer bot instance
+     * @param {Function} isTracked - Predicate on block names (default: ores, logs, containers)
+     */
+    constructor(bot, isTracked = BlockIndex.defaultTracked)
+    {
+        this.bot = bot;
+
+        this.trackedIds = new Set();
+        this.trackedStates = new Set();
+        for (const block of bot.registry.blocksArray)
+        {
+            if (!isTracked(block.name)) continue;
+
+            this.trackedIds.add(block.id);
+            for (let state = block.minStateId; state <= block.maxStateId; state++) this.trackedStates.add(state);
+        }
+
+        this.byType = new Map();  // name -> Map(posKey -> { x, y, z })
+        this.byChunk = new Map(); // chunkKey -> Map(posKey -> name)
+        this.seedCenter = null;
+        this.seedRadius = 0;
+
+        this.onBlockUpdate = (oldBlock, newBlock) => this.handleBlockUpdate(oldBlock, newBlock);
+        this.onChunkLoad = (pos) => this.handleChunkLoad(pos);
+        this.onChunkUnload = (pos) => this.dropChunk(pos.x >> 4, pos.z >> 4);
+        this.bot.on('blockUpdate', this.onBlockUpdate);
+        this.bot.on('chunkColumnLoad', this.onChunkLoad);
+        this.bot.on('chunkColumnUnload', this.onChunkUnload);
+    }
+
+    //* INDEX MAINTENANCE
+
+    /**
+     * @brief Scans the loaded world around a point for tracked blocks
+     * @details A scan cut short by SEED_LIMIT only covers the sphere up to the farthest
+     *          block it returned, so the seeded radius shrinks to that distance.
+     * @param {Object} point - Vec3 centre of the scan
+     * @param {number} radius - Scan radius (default: 64)
+     */
+    seed(point, radius = SEED_RADIUS)
+    {
+        const positions = this.bot.findBlocks
+        ({
+            point: point,
+            matching: [...this.trackedIds],
+            maxDistance: radius,
+            count: SEED_LIMIT
+        });
+
+        for (const pos of positions)
+        {
+            const block = this.bot.blockAt(pos);
+            if (block) this.add(block.name, pos);
+        }
+
+        this.seedCenter = point.clone();
+        this.seedRadius = positions.length < SEED_LIMIT ? radius :
+            point.distanceTo(positions[positions.length - 1].offset(0.5, 0.5, 0.5));
+    }
+
+    /**
+     * @brief Indexes a chunk column that loaded inside the seeded sphere
+     * @details Sections whose palette holds no tracked state are skipped without
+     *          reading a block, as findBlocks does; chunks outside the sphere are left
+     *          to the next seeding scan.
+     * @param {Object} pos - Vec3 corner of the loaded column
+     */
+    handleChunkLoad(pos)
+    {
+        if (!this.seedCenter) return;
+
+        const center = this.seedCenter;
+        const dx = Math.max(pos.x - center.x, 0, center.x - (pos.x + SECTION_SIZE));
+        const dz = Math.max(pos.z - center.z, 0, center.z - (pos.z + SECTION_SIZE));
+        if (dx * dx + dz * dz > this.seedRadius * this.seedRadius) return;
+
+        const column = this.bot.world.getColumnAt(pos);
+        if (!column) return;
+
+        this.dropChunk(pos.x >> 4, pos.z >> 4);
+
+        const minY = column.minY || 0;
+        const fromY = Math.max(minY, Math.floor(center.y - this.seedRadius));
+        const toY = Math.min(minY + (column.worldHeight || 256) - 1, Math.ceil(center.y + this.seedRadius));
+        const local = new Vec3(0, 0, 0);
+
+        for (let sectionY = fromY - ((fromY - minY) % SECTION_SIZE); sectionY <= toY; sectionY += SECTION_SIZE)
+        {
+            if (!this.sectionMayTrack(column.sections[(sectionY - minY) >> 4])) continue;
+
+            for (let y = Math.max(sectionY, fromY); y <= Math.min(sectionY + SECTION_SIZE - 1, toY); y++)
+            {
+                for (let z = 0; z < SECTION_SIZE; z++)
+                {
+                    for (let x = 0; x < SECTION_SIZE; x++)
+                    {
+                        const state = column.getBlockStateId(local.set(x, y, z));
+                        if (!this.trackedStates.has(state)) continue;
+
+                        this.add(this.bot.registry.blocksByStateId[state].name, { x: pos.x + x, y, z: pos.z + z });
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Checks a chunk section's palette for tracked block states
+     * @param {Object} section - Chunk section, or null when empty
+     * @returns {boolean} True if the section may hold a tracked block
+     */
+    sectionMayTrack(section)
+    {
+        if (!section) return false;
+        if (!section.palette) return true;
+
+        for (const state of section.palette)
+        {
+            if (this.trackedStates.has(state)) return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Keeps the index exact when a block changes
+     * @param {Object|null} oldBlock - Block before the update
+     * @param {Object} newBlock - Block after the update
+     */
+    handleBlockUpdate(oldBlock, newBlock)
+    {
+        if (oldBlock && this.trackedIds.has(oldBlock.type)) this.remove(oldBlock.name, oldBlock.position);
+        if (newBlock && this.trackedIds.has(newBlock.type)) this.add(newBlock.name, newBlock.position);
+    }
+
+    /**
+     * @brief Adds a tracked block position
+     * @param {string} name - Block name
+     * @param {Object} pos - Block position
+     */
+    add(name, pos)
+    {
+        const key = BlockIndex.keyOf(pos);
+        const chunkKey = `${pos.x >> 4},${pos.z >> 4}`;
+
+        if (!this.byType.has(name)) this.byType.set(name, new Map());
+        this.byType.get(name).set(key, { x: pos.x, y: pos.y, z: pos.z });
+
+        if (!this.byChunk.has(chunkKey)) this.byChunk.set(chunkKey, new Map());
+        this.byChunk.get(chunkKey).set(key, name);
+    }
+
+    /**
+     * @brief Removes a tracked block position
+     * @param {string} name - Block name
+     * @param {Object} pos - Block position
+     */
+    remove(name, pos)
+    {
+        const key = BlockIndex.keyOf(pos);
+        const chunkKey = `${pos.x >> 4},${pos.z >> 4}`;
+
+        const positions = this.byType.get(name);
+        if (positions) positions.delete(key);
+
+        const chunk = this.byChunk.get(chunkKey);
+        if (chunk) chunk.delete(key);
+    }
+
+    /**
+     * @brief Forgets every position in an unloaded chunk column
+     * @param {number} chunkX - Chunk X coordinate
+     * @param {number} chunkZ - Chunk Z coordinate
+     */
+    dropChunk(chunkX, chunkZ)
+    {
+        const chunkKey = `${chunkX},${chunkZ}`;
+        const chunk = this.byChunk.get(chunkKey);
+        if (!chunk) return;
+
+        for (const [key, name] of chunk)
+        {
+            const positions = this.byType.get(name);
+            if (positions) positions.delete(key);
+        }
+        this.byChunk.delete(chunkKey);
+    }
+
+    /**
+     * @brief Forgets the indexed positions after a reconnect, keeping the tracked block ids
+     * @details Updates missed while disconnected could have left stale entries; the next
+     *          query seeds the index again from the freshly loaded chunks.
+     */
+    reattach()
+    {
+        this.byType.clear();
+        this.byChunk.clear();
+        this.seedCenter = null;
+        this.seedRadius = 0;
+    }
+
+    /**
+     * @brief Unsubscribes the index from world events
+     */
+    detach()
+    {
+        this.bot.removeListener('blockUpdate', this.onBlockUpdate);
+        this.bot.removeListener('chunkColumnLoad', this.onChunkLoad);
+        this.bot.removeListener('chunkColumnUnload', this.onChunkUnload);
+    }
+
+    //* QUERIES
+
+    /**
+     * @brief Finds indexed blocks whose name passes a filter, nearest first
+     * @param {Function|Array<string>} names - Block names or a predicate on names
+     * @param {Object} point - Vec3 reference point
+     * @param {number} maxDistance - Maximum distance from the point
+     * @param {number} count - Maximum number of results (default: unlimited)
+     * @returns {Array} Positions with x, y, z and name
+     */
+    find(names, point, maxDistance, count = Infinity)
+    {
+        this.ensureCoverage(point, maxDistance);
+
+        const accepts = typeof names === 'function' ? names : (name) => names.includes(name);
+        const limit = maxDistance * maxDistance;
+        const results = [];
+
+        for (const [name, positions] of this.byType)
+        {
+            if (!accepts(name)) continue;
+
+            for (const pos of positions.values())
+            {
+                const dx = pos.x + 0.5 - point.x, dy = pos.y + 0.5 - point.y, dz = pos.z + 0.5 - point.z;
+                const distance = dx * dx + dy * dy + dz * dz;
+                if (distance <= limit) results.push({ x: pos.x, y: pos.y, z: pos.z, name, distance });
+            }
+        }
+
+        results.sort((a, b) => a.distance - b.distance);
+        return results.slice(0, count);
+    }
+
+    /**
+     * @brief Finds the nearest indexed block passing a filter
+     * @param {Function|Array<string>} names - Block names or a predicate on names
+     * @param {Object} point - Vec3 reference point
+     * @param {number} maxDistance - Maximum distance from the point
+     * @returns {Object|null} Position with x, y, z and name, or null
+     */
+    nearest(names, point, maxDistance)
+    {
+        const found = this.find(names, point, maxDistance, 1);
+        return found.length > 0 ? found[0] : null;
+    }
+
+    /**
+     * @brief Checks whether a position holds a tracked block
+     * @param {Object} pos - Block position
+     * @returns {string|null} Block name, or null if not indexed
+     */
+    nameAt(pos)
+    {
+        const chunk = this.byChunk.get(`${pos.x >> 4},${pos.z >> 4}`);
+        return chunk ? chunk.get(BlockIndex.keyOf(pos)) || null : null;
+    }
+
+    /**
+     * @brief Reseeds the index if a query sphere leaves the scanned area
+     * @param {Object} point - Query centre
+     * @param {number} maxDistance - Query radius
+     */
+    ensureCoverage(point, maxDistance)
+    {
+        if (this.seedCenter && this.seedCenter.distanceTo(point) + maxDistance <= this.seedRadius) return;
+        this.seed(point, Math.max(SEED_RADIUS, maxDistance));
+    }
+
+    //* HELPERS
+
+    /**
+     * @brief Default tracking predicate: ores, logs and containers
+     * @param {string} name - Block name
+     * @returns {boolean} True if the block type is tracked
+     */
+    static defaultTracked(name)
+    {
+        return TRACKED_NAMES.includes(name) || TRACKED_SUFFIXES.some(suffix => name.endsWith(suffix));
+    }
+
+    /**
+     * @brief Builds the key of a block position
+     * @param {Object} pos - Block position
+     * @returns {string} Key in "x,y,z" form
+     */
+    static keyOf(pos)
+    {
+        return `${pos.x},${pos.y},${pos.z}`;
+    }
+}
+
+module.exports = BlockIndex;
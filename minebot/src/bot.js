@@ -15,12 +15,19 @@
     * INCLUDES AND DEPENDENCIES *
    ************************************************************************************** */
 
-const mineflayer = require('mineflayer');
 const { pathfinder, Movements } = require('mineflayer-pathfinder');
 const { mineflayer: mineflayerViewer } = require('prismarine-viewer');
 
 const BotActions = require('./actions');
+const InventoryIndex = require('./inventory');
+const ContainerMemory = require('./containers');
+const BlockIndex = require('./blockindex');
+const EntityGrid = require('./entities');
 const NavigationStateMachine = require('./behaviors');
+const CommandTable = require('./commands');
+const TelemetryServer = require('./telemetry');
+const CheckpointStore = require('./checkpoint');
+const ConnectionManager = require('./connection');
 
 
 /* **************************************************************************************
@@ -43,9 +50,33 @@ const VIEWER_CONFIG =
     firstPerson: false
 };
 
-// Connection timeout duration in milliseconds
+// Local WebSocket telemetry and fleet command server configuration
+const TELEMETRY_CONFIG =
+{
+    host: '127.0.0.1',
+    port: 3008,
+    interval: 500
+};
+
+// Players allowed to steer the bot with '!' chat commands; chat from anyone else is ignored
+const COMMAND_CONFIG =
+{
+    owners: []
+};
+
+// Mission file describing goals and states (default: missions/default.json)
+const MISSION_FILE = process.argv[2] || null;
+
+// Time a connection attempt may take to spawn before it is retried, in milliseconds
 const CONNECTION_TIMEOUT = 30000;
 
+// Interval between mission checkpoints in milliseconds
+const CHECKPOINT_INTERVAL = 5000;
+
+// Reconnect backoff: the jittered delay cap doubles per failed attempt up to the maximum
+const RECONNECT_DELAY = 1000;
+const MAX_RECONNECT_DELAY = 30000;
+
 
 /* **************************************************************************************
     * CLASS IMPLEMENTATIONS *
@@ -62,44 +93,44 @@ class MinecraftBot
      */
     constructor()
     {
-        this.bot = null;
+        // Components hold the connection's stable handle, which survives reconnects
+        this.connection = new ConnectionManager(BOT_CONFIG,
+        {
+            plugins: [pathfinder],
+            attemptTimeout: CONNECTION_TIMEOUT,
+            baseDelay: RECONNECT_DELAY,
+            maxDelay: MAX_RECONNECT_DELAY
+        });
+        this.bot = this.connection.handle;
         this.actions = null;
+        this.inventory = null;
+        this.containers = null;
+        this.blocks = null;
+        this.entities = null;
         this.stateMachine = null;
+        this.commands = null;
         this.isReady = false;
         this.viewerStarted = false;
+        
+        // Recovery management
+        this.checkpoints = new CheckpointStore();
     }
 
     //* CONNECTION AND INITIALIZATION
 
     /**
      * @brief Establishes connection to Minecraft server and initializes bot systems
+     * @details Failed or timed out attempts are retried with jittered backoff, so the
+     *          returned promise only settles once the bot has spawned.
      * @returns {Promise<MinecraftBot>} Promise resolving to initialized bot instance
-     * @throws {Error} If connection fails or times out
      */
     async start()
     {
         console.log('Creating Minecraft bot...');
         
-        this.bot = mineflayer.createBot(BOT_CONFIG);
-        this.bot.loadPlugin(pathfinder);
         this.setupEvents();
-        
-        return new Promise((resolve, reject) =>
-        {
-            this.bot.once('spawn', () => {resolve(this);});
-            
-            this.bot.on('error', (err) => 
-            {
-                console.error('Bot error:', err);
-                reject(err);
-            });
-
-            setTimeout(() => 
-            {
-                if (!this.isReady)
-                {reject(new Error('Bot connection timeout'));}
-            }, CONNECTION_TIMEOUT);
-        });
+        await this.connection.connect();
+        return this;
     }
 
     /**
@@ -110,17 +141,78 @@ class MinecraftBot
         this.bot.on('login', () =>
         {console.log(`Bot logged in as ${this.bot.username}`);});
 
-        this.bot.once('spawn', () =>
-        {this.onSpawn();});
+        this.connection.on('ready', (reconnected) =>
+        {
+            if (reconnected) {this.onReconnect();}
+            else {this.onSpawn();}
+        });
 
-        this.bot.on('end', () =>
+        this.connection.on('lost', () =>
         {
             console.log('Bot disconnected from server');
             this.isReady = false;
-            this.viewerStarted = false;
+            this.suspend();
         });
     }
 
+    //* RECOVERY
+
+    /**
+     * @brief Saves a last checkpoint and pauses the state machine while disconnected
+     */
+    suspend()
+    {
+        this.checkpoints.stop();
+        
+        if (this.stateMachine)
+        {
+            this.checkpoints.checkpoint();
+            this.stateMachine.stop();
+        }
+    }
+
+    /**
+     * @brief Resumes on a new connection, reusing every component built on the first spawn
+     * @details Listeners live on the connection handle and carry over; indexes only drop
+     *          the world state of the lost connection. Nothing is reloaded from disk.
+     */
+    onReconnect()
+    {
+        if (!this.stateMachine)
+        {
+            this.onSpawn();
+            return;
+        }
+
+        const start = Date.now();
+        this.inventory.reattach();
+        this.containers.reattach();
+        this.blocks.reattach();
+        this.entities.reattach();
+        this.actions.reattach();
+        this.stateMachine.reattach();
+        
+        const stateMachine = this.stateMachine;
+        this.checkpoints.start(() => stateMachine.checkpoint(), CHECKPOINT_INTERVAL);
+        this.isReady = true;
+        console.log(`Reconnected, resynchronized in ${Date.now() - start} ms`);
+    }
+
+    /**
+     * @brief Resumes mission progress from the last checkpoint, if it belongs to this mission
+     */
+    restoreCheckpoint()
+    {
+        try
+        {
+            this.stateMachine.restore(this.checkpoints.load());
+        }
+        catch (error)
+        {
+            console.log(`Checkpoint ignored: ${error.message}`);
+        }
+    }
+
     /**
      * @brief Handles bot spawn event with system initialization and autonomous mode startup
      */
@@ -136,8 +228,22 @@ class MinecraftBot
         if (!this.viewerStarted)
             {this.setupViewer();}
         
-        this.actions = new BotActions(this.bot);
-        this.stateMachine = new NavigationStateMachine(this.bot, this.actions);
+        this.inventory = new InventoryIndex(this.bot);
+        this.containers = new ContainerMemory(this.bot);
+        this.blocks = new BlockIndex(this.bot);
+        this.entities = new EntityGrid(this.bot);
+        this.actions = new BotActions(this.bot, this.inventory, this.containers, this.blocks, this.entities);
+        this.stateMachine = new NavigationStateMachine(this.bot, this.actions, MISSION_FILE);
+        
+        // Pick up where the last process left off, then keep checkpointing
+        this.restoreCheckpoint();
+        const stateMachine = this.stateMachine;
+        this.checkpoints.start(() => stateMachine.checkpoint(), CHECKPOINT_INTERVAL);
+        
+        // Live mission control from the game chat ('!goto ...') and the local terminal
+        this.commands = new CommandTable(this.stateMachine, this.actions);
+        this.commands.attachChat(this.bot, COMMAND_CONFIG.owners);
+        this.commands.attachTerminal();
         
         this.isReady = true;
     }
@@ -179,15 +285,19 @@ async function main()
     {
         const minecraftBot = new MinecraftBot();
         await minecraftBot.start();
+
+        const telemetry = new TelemetryServer(TELEMETRY_CONFIG);
+        telemetry.register(0, minecraftBot);
+        await telemetry.start();
         
-        process.on('SIGINT', () =>
+        process.on('SIGINT', async () =>
         {
             console.log('\nShutting down bot...');
-            if (minecraftBot.stateMachine)
-                {minecraftBot.stateMachine.stop();}
+            telemetry.stop();
+            minecraftBot.suspend();
+            await minecraftBot.checkpoints.writing;
             
-            if (minecraftBot.bot)
-                {minecraftBot.bot.quit();}
+            minecraftBot.connection.stop();
             process.exit(0);
         });
     }
@@ -0,0 +1,197 @@
+/** *************************************************************************************
+
+    * @file        chat.js
+    * @brief       Outbound chat scheduler with rate limiting, coalescing and splitting
+    * @author      Agustín I. Galdeman
+    * @author      Ian A. Dib
+    * @author      Luciano S. Cordero
+    * @date        2025-07-19
+    * @version     1.0 - Initial chat scheduler module
+
+    ************************************************************************************* */
+
+
+/* **************************************************************************************
+    * CONSTANTS AND STATIC DATA *
+   ************************************************************************************** */
+
+// Longest chat message accepted by the server protocol
+const MAX_MESSAGE_LENGTH = 256;
+
+// Room kept at the end of each part for the repeat counter, e.g. " (x12)"
+const COUNTER_ROOM = 8;
+
+// Token bucket: burst size and milliseconds needed to earn one message
+const BURST = 3;
+const REFILL_INTERVAL = 1500;
+
+// Messages allowed to wait before the drop policy applies
+const MAX_QUEUE = 16;
+
+// Drop policies: discard the oldest waiting message or refuse the new one
+const DROP_POLICIES = ['drop_oldest', 'drop_newest'];
+
+
+/* **************************************************************************************
+    * CLASS IMPLEMENTATIONS *
+   ************************************************************************************** */
+
+/**
+ * @class ChatScheduler
+ * @brief Sends chat messages through a token bucket so the bot never gets kicked for spam
+ * @details Long messages are split at word boundaries under the protocol limit. A
+ *          message identical to one still waiting is merged into it and sent once with
+ *          a repeat counter. When the queue is full the drop policy decides whether the
+ *          oldest waiting message or the new one is discarded.
+ */
+class ChatScheduler
+{
+    /**
+     * @brief Constructor initializes the token bucket
+     * @param {Object} bot - Mineflayer bot instance
+     * @param {Object} options - { burst, refillInterval, maxQueue, policy } overriding defaults
+     * @throws {Error} If the drop policy is unknown
+     */
+    constructor(bot, options = {})
+    {
+        this.bot = bot;
+        this.burst = options.burst || BURST;
+        this.refillInterval = options.refillInterval || REFILL_INTERVAL;
+        this.maxQueue = options.maxQueue || MAX_QUEUE;
+        this.policy = options.policy || DROP_POLICIES[0];
+
+        if (!DROP_POLICIES.includes(this.policy)) throw new Error(`Invalid drop policy: ${this.policy}`);
+
+        this.tokens = this.burst;
+        this.lastRefill = Date.now();
+        this.queue = []; // { text, count }
+        this.timer = null;
+        this.stats = { sent: 0, coalesced: 0, dropped: 0 };
+    }
+
+    //* SUBMISSION
+
+    /**
+     * @brief Schedules a message, splitting it if it is too long
+     * @param {string} message - Message text
+     * @returns {number} Number of parts queued or merged
+     */
+    send(message)
+    {
+        const parts = ChatScheduler.split(String(message), MAX_MESSAGE_LENGTH - COUNTER_ROOM);
+        parts.forEach(part => this.enqueue(part));
+        this.flush();
+        return parts.length;
+    }
+
+    /**
+     * @brief Queues one part, merging it with an identical waiting part
+     * @param {string} text - Message part within the length limit
+     */
+    enqueue(text)
+    {
+        const waiting = this.queue.find(entry => entry.text === text);
+        if (waiting)
+        {
+            waiting.count++;
+            this.stats.coalesced++;
+            return;
+        }
+
+        if (this.queue.length >= this.maxQueue)
+        {
+            this.stats.dropped++;
+            if (this.policy === 'drop_newest') return;
+            this.queue.shift();
+        }
+
+        this.queue.push({ text, count: 1 });
+    }
+
+    //* SENDING
+
+    /**
+     * @brief Sends as many waiting messages as the bucket allows and schedules the rest
+     */
+    flush()
+    {
+        this.refill();
+
+        while (this.queue.length > 0 && this.tokens >= 1)
+        {
+            const entry = this.queue.shift();
+            this.bot.chat(entry.count > 1 ? `${entry.text} (x${entry.count})` : entry.text);
+            this.tokens--;
+            this.stats.sent++;
+        }
+
+        if (this.queue.length > 0 && !this.timer)
+        {
+            const wait = Math.ceil((1 - this.tokens) * this.refillInterval);
+            this.timer = setTimeout(() =>
+            {
+                this.timer = null;
+                this.flush();
+            }, wait);
+        }
+    }
+
+    /**
+     * @brief Adds the tokens earned since the last refill
+     */
+    refill()
+    {
+        const now = Date.now();
+        this.tokens = Math.min(this.burst, this.tokens + (now - this.lastRefill) / this.refillInterval);
+        this.lastRefill = now;
+    }
+
+    /**
+     * @brief Drops every waiting message and stops the flush timer
+     */
+    detach()
+    {
+        if (this.timer) clearTimeout(this.timer);
+        this.timer = null;
+        this.queue = [];
+    }
+
+    //* QUERIES
+
+    /**
+     * @brief Number of message parts waiting for a token
+     * @returns {number} Queue length
+     */
+    pendingCount()
+    {
+        return this.queue.length;
+    }
+
+    //* HELPERS
+
+    /**
+     * @brief Splits a message into parts under a length limit, preferring word boundaries
+     * @param {string} message - Message text
+     * @param {number} limit - Maximum part length
+     * @returns {Array<string>} Message parts
+     */
+    static split(message, limit)
+    {
+        const parts = [];
+        let rest = message.trim();
+
+        while (rest.length > limit)
+        {
+            let cut = rest.lastIndexOf(' ', limit);
+            if (cut <= 0) cut = limit;
+
+            parts.push(rest.slice(0, cut).trim());
+            rest = rest.slice(cut).trim();
+        }
+
+        if (rest.length > 0) parts.push(rest);
+        return parts;
+    }
+}
+
+module.exports = ChatScheduler;
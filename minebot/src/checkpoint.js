@@ -0,0 +1,149 @@
+/** *************************************************************************************
+
+    * @file        checkpoint.js
+    * @brief       Periodic atomic checkpoints of mission progress for crash and disconnect recovery
+    * @author      Agustín I. Galdeman
+    * @author      Ian A. Dib
+    * @author      Luciano S. Cordero
+    * @date        2025-07-25
+    * @version     1.0 - Initial checkpoint store module
+
+    ************************************************************************************* */
+
+
+/* **************************************************************************************
+    * INCLUDES AND DEPENDENCIES *
+   ************************************************************************************** */
+
+const fs = require('fs');
+const path = require('path');
+
+
+/* **************************************************************************************
+    * CONSTANTS AND STATIC DATA *
+   ************************************************************************************** */
+
+// Default location of the checkpoint file
+const DEFAULT_CHECKPOINT_PATH = path.join(__dirname, '..', 'data', 'checkpoint.json');
+
+// Default interval between checkpoints in milliseconds
+const CHECKPOINT_INTERVAL = 5000;
+
+// Checkpoint format version; files with another version are ignored
+const CHECKPOINT_VERSION = 1;
+
+
+/* **************************************************************************************
+    * CLASS IMPLEMENTATIONS *
+   ************************************************************************************** */
+
+/**
+ * @class CheckpointStore
+ * @brief Writes a compact JSON snapshot of mission progress on a timer and reads it back
+ * @details Each write goes to a temporary file renamed over the checkpoint, so a crash
+ *          mid-write leaves the previous checkpoint intact. Writes are serialized and
+ *          skipped when the snapshot did not change since the last one.
+ */
+class CheckpointStore
+{
+    /**
+     * @brief Constructor initializes an idle store
+     * @param {string} storePath - JSON file used for checkpoints (default: data/checkpoint.json)
+     */
+    constructor(storePath = DEFAULT_CHECKPOINT_PATH)
+    {
+        this.storePath = storePath;
+        this.capture = null;
+        this.timer = null;
+        this.lastWritten = null;
+        this.writing = Promise.resolve();
+        this.stats = { written: 0, skipped: 0 };
+    }
+
+    //* PERIODIC CHECKPOINTS
+
+    /**
+     * @brief Starts checkpointing a snapshot source on a timer
+     * @param {Function} capture - () => Object, snapshot of the current progress
+     * @param {number} interval - Milliseconds between checkpoints (default: 5000)
+     */
+    start(capture, interval = CHECKPOINT_INTERVAL)
+    {
+        this.stop();
+        this.capture = capture;
+        this.timer = setInterval(() => this.checkpoint(), interval);
+        this.timer.unref();
+    }
+
+    /**
+     * @brief Stops the checkpoint timer
+     */
+    stop()
+    {
+        if (this.timer) clearInterval(this.timer);
+        this.timer = null;
+    }
+
+    /**
+     * @brief Captures and writes one checkpoint right away, e.g. on disconnect or shutdown
+     * @returns {Promise} Resolves once the checkpoint is on disk
+     */
+    checkpoint()
+    {
+        if (!this.capture) return this.writing;
+        return this.save(this.capture()).catch(error => console.log(`Checkpoint not saved: ${error.message}`));
+    }
+
+    //* PERSISTENCE
+
+    /**
+     * @brief Writes a snapshot atomically, after any write still in progress
+     * @param {Object} snapshot - Progress snapshot
+     * @returns {Promise} Resolves once the file is replaced or the write is skipped
+     */
+    save(snapshot)
+    {
+        const data = JSON.stringify(Object.assign({ version: CHECKPOINT_VERSION }, snapshot));
+        if (data === this.lastWritten)
+        {
+            this.stats.skipped++;
+            return this.writing;
+        }
+
+        // Only a snapshot that reached the file may skip later identical ones, so a
+        // failed write is retried on the next checkpoint
+        const tempPath = `${this.storePath}.tmp`;
+        this.writing = this.writing.catch(() => {}).then(async () =>
+        {
+            await fs.promises.mkdir(path.dirname(this.storePath), { recursive: true });
+            await fs.promises.writeFile(tempPath, data);
+            await fs.promises.rename(tempPath, this.storePath);
+            this.lastWritten = data;
+            this.stats.written++;
+        });
+
+        return this.writing;
+    }
+
+    /**
+     * @brief Reads the checkpoint, ignoring a missing, corrupt or outdated file
+     * @returns {Object|null} Snapshot, or null if there is none to resume from
+     */
+    load()
+    {
+        let data;
+        try
+        {
+            data = JSON.parse(fs.readFileSync(this.storePath, 'utf8'));
+        }
+        catch (error)
+        {
+            if (error.code !== 'ENOENT') console.log(`Checkpoint not loaded: ${error.message}`);
+            return null;
+        }
+
+        return data.version === CHECKPOINT_VERSION ? data : null;
+    }
+}
+
+module.exports = CheckpointStore;
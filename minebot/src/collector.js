@@ -0,0 +1,217 @@
+/** *************************************************************************************
+
+    * @file        collector.js
+    * @brief       Tracking and time-boxed route collection of item drops after digging
+    * @author      Agustín I. Galdeman
+    * @author      Ian A. Dib
+    * @author      Luciano S. Cordero
+    * @date        2025-07-12
+    * @version     1.0 - Initial drop collector module
+
+    ************************************************************************************* */
+
+
+/* **************************************************************************************
+    * INCLUDES AND DEPENDENCIES *
+   ************************************************************************************** */
+
+const Abortable = require('./abort');
+const StorageRun = require('./storage');
+
+
+/* **************************************************************************************
+    * CONSTANTS AND STATIC DATA *
+   ************************************************************************************** */
+
+// How long a finished dig attracts drops, in milliseconds
+const DIG_MEMORY = 10000;
+
+// Maximum distance between a dig and an item entity attributed to it
+const DROP_RADIUS = 4;
+
+// Horizontal distance at which an item is considered picked up
+const PICKUP_RADIUS = 1;
+
+// Default time budget of a collection round in milliseconds
+const COLLECT_BUDGET = 5000;
+
+// Maximum number of remembered digs
+const MAX_RECENT_DIGS = 64;
+
+
+/* **************************************************************************************
+    * CLASS IMPLEMENTATIONS *
+   ************************************************************************************** */
+
+/**
+ * @class DropCollector
+ * @brief Remembers item entities spawned near recent digs and picks them up on a short route
+ * @details Digs are recorded from 'diggingCompleted', item entities from 'entitySpawn'
+ *          and forgotten on 'entityGone'. A collection round orders the pending drops
+ *          as a small nearest neighbour + 2-opt tour and walks it until the time
+ *          budget runs out, so mining never stalls on a drop that fell somewhere awkward.
+ */
+class DropCollector
+{
+    /**
+     * @brief Constructor subscribes to dig and entity events
+     * @param {Object} bot - Mineflayer bot instance
+     * @param {Object} actions - BotActions instance used to walk
+     */
+    constructor(bot, actions)
+    {
+        this.bot = bot;
+        this.actions = actions;
+
+        this.recentDigs = []; // { x, y, z, time }
+        this.pending = new Map(); // entity id -> entity
+        this.stats = { collected: 0, abandoned: 0 };
+
+        this.onDig = (block) => this.recordDig(block.position);
+        this.onSpawn = (entity) => this.handleSpawn(entity);
+        this.onGone = (entity) => this.handleGone(entity);
+
+        this.bot.on('diggingCompleted', this.onDig);
+        this.bot.on('entitySpawn', this.onSpawn);
+        this.bot.on('entityGone', this.onGone);
+    }
+
+    //* TRACKING
+
+    /**
+     * @brief Remembers where a block was just broken
+     * @param {Object} pos - Block position
+     */
+    recordDig(pos)
+    {
+        this.recentDigs.push({ x: pos.x + 0.5, y: pos.y, z: pos.z + 0.5, time: Date.now() });
+        if (this.recentDigs.length > MAX_RECENT_DIGS) this.recentDigs.shift();
+    }
+
+    /**
+     * @brief Starts tracking item entities that appear near a recent dig
+     * @param {Object} entity - Spawned entity
+     */
+    handleSpawn(entity)
+    {
+        if (entity.name !== 'item') return;
+
+        const now = Date.now();
+        while (this.recentDigs.length > 0 && now - this.recentDigs[0].time > DIG_MEMORY) this.recentDigs.shift();
+
+        const pos = entity.position;
+        const near = this.recentDigs.some(dig =>
+            Math.abs(dig.x - pos.x) <= DROP_RADIUS &&
+            Math.abs(dig.y - pos.y) <= DROP_RADIUS &&
+            Math.abs(dig.z - pos.z) <= DROP_RADIUS);
+
+        if (near) this.pending.set(entity.id, entity);
+    }
+
+    /**
+     * @brief Stops tracking an entity that was picked up or despawned
+     * @param {Object} entity - Removed entity
+     */
+    handleGone(entity)
+    {
+        if (this.pending.delete(entity.id) && this.isClose(entity.position)) this.stats.collected++;
+    }
+
+    /**
+     * @brief Forgets the digs and drops of a lost connection
+     */
+    reattach()
+    {
+        this.recentDigs = [];
+        this.pending.clear();
+    }
+
+    /**
+     * @brief Number of drops waiting to be picked up
+     * @returns {number} Pending drop count
+     */
+    pendingCount()
+    {
+        return this.pending.size;
+    }
+
+    //* COLLECTION
+
+    /**
+     * @brief Walks a short route over the pending drops within a time budget
+     * @param {Object} options - { budget } in milliseconds (default: 5000) and an optional
+     *                          AbortSignal as signal
+     * @returns {Object} Drops collected during the round and drops left behind
+     * @throws {Error} AbortError when cancelled
+     */
+    async collect({ budget = COLLECT_BUDGET, signal = null } = {})
+    {
+        const deadline = Date.now() + budget;
+        const before = this.stats.collected;
+
+        const start = this.bot.entity.position;
+        const route = StorageRun.order(start, [...this.pending.values()].map(entity => entity.position),
+            (a, b) => Math.abs(a.x - b.x) + Math.abs(a.z - b.z) + Math.abs(a.y - b.y) * 2);
+
+        for (const target of route)
+        {
+            while (Date.now() < deadline && !this.isClose(target))
+            {
+                const pos = this.bot.entity.position;
+                Abortable.check(signal);
+                const moved = await this.stepToward(target, signal);
+                if (!moved || pos.distanceTo(this.bot.entity.position) < 0.1) break;
+            }
+
+            if (Date.now() >= deadline) break;
+        }
+
+        const collected = this.stats.collected - before;
+        const left = this.pending.size;
+        this.stats.abandoned += left;
+        this.pending.clear();
+
+        return { collected, left };
+    }
+
+    /**
+     * @brief Takes one cardinal step toward a point, jumping over single blocks
+     * @param {Object} target - Target position
+     * @param {AbortSignal} signal - Cancellation signal (optional)
+     * @returns {boolean} False if the bot is already aligned with the target
+     */
+    async stepToward(target, signal = null)
+    {
+        const pos = this.bot.entity.position;
+        const dx = target.x - pos.x;
+        const dz = target.z - pos.z;
+
+        if (Math.abs(dx) < 0.5 && Math.abs(dz) < 0.5) return false;
+
+        let direction;
+        if (Math.abs(dx) >= Math.abs(dz)) direction = dx > 0 ? 'east' : 'west';
+        else direction = dz > 0 ? 'south' : 'north';
+
+        const floor = this.actions.position();
+        const step = { east: [1, 0], west: [-1, 0], south: [0, 1], north: [0, -1] }[direction];
+        const front = this.actions.block_at(floor.x + step[0], floor.y, floor.z + step[1]);
+
+        if (front && front.boundingBox === 'block') this.actions.jump();
+        await this.actions.step(direction, false, { signal });
+        return true;
+    }
+
+    /**
+     * @brief Checks whether the bot stands close enough to a point to pick it up
+     * @param {Object} pos - Item position
+     * @returns {boolean} True if within pickup radius
+     */
+    isClose(pos)
+    {
+        const self = this.bot.entity.position;
+        return Math.abs(self.x - pos.x) <= PICKUP_RADIUS && Math.abs(self.z - pos.z) <= PICKUP_RADIUS &&
+            Math.abs(self.y - pos.y) <= 2;
+    }
+}
+
+module.exports = DropCollector;
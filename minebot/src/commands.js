@@ -0,0 +1,301 @@
+/** *************************************************************************************
+
+    * @file        commands.js
+    * @brief       Command table for steering a running bot from chat or the terminal
+    * @author      Agustín I. Galdeman
+    * @author      Ian A. Dib
+    * @author      Luciano S. Cordero
+    * @date        2025-07-20
+    * @version     1.0 - Initial command interface module
+
+    ************************************************************************************* */
+
+
+/* **************************************************************************************
+    * INCLUDES AND DEPENDENCIES *
+   ************************************************************************************** */
+
+const readline = require('readline');
+
+
+/* **************************************************************************************
+    * CONSTANTS AND STATIC DATA *
+   ************************************************************************************** */
+
+// Prefix marking a chat message as a command
+const CHAT_PREFIX = '!';
+
+// Goal types accepted by setgoal
+const GOAL_TYPES = new Set(['waypoint', 'chest_location', 'final_destination']);
+
+
+/* **************************************************************************************
+    * CLASS IMPLEMENTATIONS *
+   ************************************************************************************** */
+
+/**
+ * @class CommandTable
+ * @brief Prebuilt name -> handler table shared by the in-game chat and the local terminal
+ * @details A line is tokenized once and dispatched with a single map lookup; handlers run
+ *          synchronously and only preempt or redirect the state machine, so a command
+ *          takes effect on the next movement cycle without restarting the process.
+ */
+class CommandTable
+{
+    /**
+     * @brief Constructor builds the command table
+     * @param {Object} autonomous - AutonomousBot instance to steer
+     * @param {Object} actions - BotActions instance used for position and chat replies
+     */
+    constructor(autonomous, actions)
+    {
+        this.autonomous = autonomous;
+        this.actions = actions;
+        this.bot = null;
+        this.owners = new Set();
+        this.onChat = null;
+        this.terminal = null;
+
+        this.table = new Map([
+            ['goto', { usage: 'goto <x> <y> <z>', minArgs: 3, run: (args) => this.goto(args) }],
+            ['setgoal', { usage: 'setgoal <x> <y> <z> [type]', minArgs: 3, run: (args) => this.setGoal(args) }],
+            ['mine', { usage: 'mine [vein|strip|branch|quarry] [key=value ...]', minArgs: 0, run: (args) => this.mine(args) }],
+            ['harvest', { usage: 'harvest [trees=<n>] [radius=<n>] [naive=1]', minArgs: 0, run: (args) => this.harvest(args) }],
+            ['storage', { usage: 'storage [collect]', minArgs: 0, run: (args) => this.storage(args) }],
+            ['stop', { usage: 'stop', minArgs: 0, run: () => this.stop() }],
+            ['stats', { usage: 'stats', minArgs: 0, run: () => this.stats() }],
+            ['help', { usage: 'help', minArgs: 0, run: () => this.help() }]
+        ]);
+    }
+
+    //* DISPATCH
+
+    /**
+     * @brief Parses and runs one command line
+     * @param {string} line - Command line without prefix, e.g. "goto 10 64 -20"
+     * @returns {string} Reply text
+     */
+    dispatch(line)
+    {
+        const args = line.trim().split(/\s+/);
+        const name = args.shift().toLowerCase();
+        const command = this.table.get(name);
+
+        if (!command) return `Unknown command: ${name} (try help)`;
+        if (args.length < command.minArgs) return `Usage: ${command.usage}`;
+
+        try
+        {
+            return command.run(args);
+        }
+        catch (error)
+        {
+            return `${name} failed: ${error.message}`;
+        }
+    }
+
+    //* SOURCES
+
+    /**
+     * @brief Listens for prefixed commands from the owners in the game chat and answers there
+     * @details Any player on the server can write in chat, so commands from anyone outside
+     *          the owner list are ignored without a reply. With no owners chat commands
+     *          are disabled and only the terminal steers the bot.
+     * @param {Object} bot - Mineflayer bot instance
+     * @param {Array<string>} owners - Usernames allowed to send commands
+     * @param {string} prefix - Command prefix (default: '!')
+     */
+    attachChat(bot, owners = [], prefix = CHAT_PREFIX)
+    {
+        this.bot = bot;
+        this.owners = new Set(owners);
+        if (this.owners.size === 0) console.log('Chat commands disabled: no owners configured');
+
+        this.onChat = (username, message) =>
+        {
+            if (!this.owners.has(username) || !message.startsWith(prefix)) return;
+            this.actions.chat(this.dispatch(message.slice(prefix.length)));
+        };
+        bot.on('chat', this.onChat);
+    }
+
+    /**
+     * @brief Reads commands from a local stream, one per line, answering on the console
+     * @param {Object} input - Readable stream (default: process.stdin)
+     */
+    attachTerminal(input = process.stdin)
+    {
+        this.terminal = readline.createInterface({ input, terminal: false });
+        this.terminal.on('line', (line) =>
+        {
+            if (line.trim().length > 0) console.log(this.dispatch(line));
+        });
+    }
+
+    /**
+     * @brief Stops listening on every source
+     */
+    detach()
+    {
+        if (this.bot && this.onChat) this.bot.removeListener('chat', this.onChat);
+        if (this.terminal) this.terminal.close();
+        this.onChat = null;
+        this.terminal = null;
+    }
+
+    //* COMMANDS
+
+    /**
+     * @brief goto: walks to a position now, then resumes the goal list
+     * @param {Array<string>} args - x, y, z
+     * @returns {string} Reply text
+     */
+    goto(args)
+    {
+        const [x, y, z] = CommandTable.coordinates(args);
+        this.autonomous.gotoPosition(x, y, z);
+        return `Going to (${x}, ${y}, ${z})`;
+    }
+
+    /**
+     * @brief setgoal: replaces the current goal
+     * @param {Array<string>} args - x, y, z and an optional goal type
+     * @returns {string} Reply text
+     */
+    setGoal(args)
+    {
+        const [x, y, z] = CommandTable.coordinates(args);
+        const type = args[3] || 'final_destination';
+        if (!GOAL_TYPES.has(type)) throw new Error(`unknown goal type ${type}`);
+
+        this.autonomous.replaceGoal({ x, y, z, type });
+        return `Goal set to ${type} (${x}, ${y}, ${z})`;
+    }
+
+    /**
+     * @brief mine: switches to a mining mode, resuming the current task afterwards
+     * @param {Array<string>} args - Mode and key=value options
+     * @returns {string} Reply text
+     */
+    mine(args)
+    {
+        const mode = args[0] || 'vein';
+        const options = CommandTable.options(args.slice(1));
+
+        this.autonomous.preempt('mine command');
+        this.autonomous.startMining(mode, options);
+        this.autonomous.start();
+        return `Mining (${mode})`;
+    }
+
+    /**
+     * @brief harvest: fells nearby trees, resuming the current task afterwards
+     * @param {Array<string>} args - key=value options (trees, radius, naive)
+     * @returns {string} Reply text
+     */
+    harvest(args)
+    {
+        const options = CommandTable.options(args);
+        if ('naive' in options) options.naive = options.naive === 1 || options.naive === 'true';
+
+        this.autonomous.preempt('harvest command');
+        this.autonomous.startHarvesting(options);
+        this.autonomous.start();
+        return `Harvesting ${options.trees || 1} trees`;
+    }
+
+    /**
+     * @brief storage: visits the nearby chests, resuming the current task afterwards
+     * @param {Array<string>} args - Optional 'collect' to withdraw every chest's contents
+     * @returns {string} Reply text
+     */
+    storage(args)
+    {
+        const collect = args[0] === 'collect';
+        if (args.length > 0 && !collect) throw new Error(`unknown option ${args[0]}`);
+
+        this.autonomous.preempt('storage command');
+        const count = this.autonomous.startStorageRun(null, { collect });
+        if (count === 0) return 'No chests nearby';
+
+        this.autonomous.start();
+        return `Storage run over ${count} chests${collect ? ' (collecting)' : ''}`;
+    }
+
+    /**
+     * @brief stop: cancels the running action and halts the state machine
+     * @returns {string} Reply text
+     */
+    stop()
+    {
+        this.autonomous.stop();
+        return 'Stopped';
+    }
+
+    /**
+     * @brief stats: reports position, state, goal and throughput counters
+     * @returns {string} Reply text
+     */
+    stats()
+    {
+        const pos = this.actions.position();
+        const goal = this.autonomous.currentGoal;
+        const mining = this.autonomous.mining.report();
+        const looks = this.actions.lookStats;
+
+        return [
+            `pos ${pos.x},${pos.y},${pos.z}`,
+            `state ${this.autonomous.currentState}`,
+            goal ? `goal ${goal.type} ${goal.x},${goal.y},${goal.z}` : 'goal none',
+            `goals ${this.autonomous.currentGoalIndex}/${this.autonomous.goals.length}`,
+            `cost ${this.autonomous.pathfinder.travelCost}`,
+            `ores ${mining.ores} (${mining.oresPerMinute.toFixed(1)}/min)`,
+            `looks ${looks.sent} sent ${looks.skipped} skipped`,
+            `queue ${this.autonomous.queue.inFlight()} running ${this.autonomous.queue.pendingCount()} waiting`
+        ].join(' | ');
+    }
+
+    /**
+     * @brief help: lists the available commands
+     * @returns {string} Reply text
+     */
+    help()
+    {
+        return [...this.table.values()].map(command => command.usage).join(' | ');
+    }
+
+    //* HELPERS
+
+    /**
+     * @brief Parses key=value options, converting numeric values
+     * @param {Array<string>} args - Option arguments
+     * @returns {Object} Options by key
+     * @throws {Error} If an argument is not a key=value pair
+     */
+    static options(args)
+    {
+        const options = {};
+        for (const pair of args)
+        {
+            const [key, value] = pair.split('=');
+            if (!key || value === undefined) throw new Error(`bad option ${pair}`);
+            options[key] = Number.isNaN(Number(value)) ? value : Number(value);
+        }
+        return options;
+    }
+
+    /**
+     * @brief Parses three integer coordinates
+     * @param {Array<string>} args - Arguments starting with x, y, z
+     * @returns {Array<number>} x, y, z
+     * @throws {Error} If a coordinate is not a number
+     */
+    static coordinates(args)
+    {
+        const values = args.slice(0, 3).map(Number);
+        if (values.some(Number.isNaN)) throw new Error('coordinates must be numbers');
+        return values.map(Math.floor);
+    }
+}
+
+module.exports = CommandTable;
@@ -0,0 +1,231 @@
+/** *************************************************************************************
+
+    * @file        connection.js
+    * @brief       Server connection manager with jittered reconnects behind a stable bot handle
+    * @author      Agustín I. Galdeman
+    * @author      Ian A. Dib
+    * @author      Luciano S. Cordero
+    * @date        2025-07-26
+    * @version     1.0 - Initial connection manager module
+
+    ************************************************************************************* */
+
+
+/* **************************************************************************************
+    * INCLUDES AND DEPENDENCIES *
+   ************************************************************************************** */
+
+const EventEmitter = require('events');
+const mineflayer = require('mineflayer');
+
+
+/* **************************************************************************************
+    * CONSTANTS AND STATIC DATA *
+   ************************************************************************************** */
+
+// Time one connection attempt may take to reach spawn before it is abandoned
+const ATTEMPT_TIMEOUT = 30000;
+
+// Backoff: the delay cap doubles per failed attempt from BASE_DELAY up to MAX_DELAY,
+// and the actual delay is drawn uniformly below the cap (full jitter)
+const BASE_DELAY = 1000;
+const MAX_DELAY = 30000;
+
+// Time a spawned connection must stay up before the backoff restarts from BASE_DELAY,
+// so a server that accepts and then kicks the bot is not retried at full rate
+const STABLE_CONNECTION = 60000;
+
+// Listener methods recorded on the handle so they survive reconnects
+const LISTENER_METHODS = new Set(['on', 'addListener', 'removeListener', 'off']);
+
+
+/* **************************************************************************************
+    * CLASS IMPLEMENTATIONS *
+   ************************************************************************************** */
+
+/**
+ * @class ConnectionManager
+ * @brief Keeps a bot connected, retrying with jittered exponential backoff
+ * @details Components receive a handle instead of the Mineflayer bot. Property reads and
+ *          method calls go to the current connection; persistent listeners added with
+ *          on() are recorded and re-added to every new connection. Indexes, caches and
+ *          compiled tables built around the handle therefore survive a reconnect and only
+ *          resynchronize their world state, instead of being rebuilt from scratch. The
+ *          protocol version is pinned, so each connection gets its registry from
+ *          minecraft-data's per-version cache rather than loading it again.
+ *
+ *          Emits 'ready' (reconnected) on every spawn and 'lost' (reason) on every
+ *          disconnect of a connection that had spawned.
+ */
+class ConnectionManager extends EventEmitter
+{
+    /**
+     * @brief Constructor prepares the handle without connecting
+     * @param {Object} config - mineflayer.createBot options
+     * @param {Object} options - { plugins, attemptTimeout, baseDelay, maxDelay, stableTime } overriding defaults
+     */
+    constructor(config, options = {})
+    {
+        super();
+        this.config = config;
+        this.plugins = options.plugins || [];
+        this.attemptTimeout = options.attemptTimeout || ATTEMPT_TIMEOUT;
+        this.baseDelay = options.baseDelay || BASE_DELAY;
+        this.maxDelay = options.maxDelay || MAX_DELAY;
+        this.stableTime = options.stableTime || STABLE_CONNECTION;
+
+        this.bot = null;            // current Mineflayer bot
+        this.listeners = [];        // { event, listener } re-added on every connection
+        this.bound = new Map();     // bot method -> method bound to the current bot
+        this.failures = 0;
+        this.connections = 0;
+        this.retryTimer = null;
+        this.attemptTimer = null;
+        this.stableTimer = null;
+        this.stopped = false;
+
+        this.handle = this.createHandle();
+    }
+
+    //* CONNECTION
+
+    /**
+     * @brief Connects, retrying until the first spawn
+     * @returns {Promise<Object>} Resolves with the bot handle once spawned
+     */
+    connect()
+    {
+        this.stopped = false;
+        const ready = new Promise(resolve => this.once('ready', () => resolve(this.handle)));
+        this.open();
+        return ready;
+    }
+
+    /**
+     * @brief Starts one connection attempt
+     */
+    open()
+    {
+        this.retryTimer = null;
+        if (this.stopped) return;
+
+        const bot = mineflayer.createBot(this.config);
+        this.bot = bot;
+        this.bound.clear();
+
+        this.plugins.forEach(plugin => bot.loadPlugin(plugin));
+        for (const { event, listener } of this.listeners) bot.on(event, listener);
+
+        let spawned = false;
+        this.attemptTimer = setTimeout(() =>
+        {
+            console.log('Connection attempt timed out');
+            bot.end('timeout');
+        }, this.attemptTimeout);
+
+        bot.once('spawn', () =>
+        {
+            clearTimeout(this.attemptTimer);
+            spawned = true;
+            this.stableTimer = setTimeout(() => { this.failures = 0; }, this.stableTime);
+            this.emit('ready', this.connections++ > 0);
+        });
+
+        bot.on('error', (error) => console.log(`Connection error: ${error.message}`));
+
+        bot.once('end', (reason) =>
+        {
+            clearTimeout(this.attemptTimer);
+            clearTimeout(this.stableTimer);
+            if (spawned) this.emit('lost', reason);
+            if (!this.stopped && this.bot === bot) this.scheduleRetry();
+        });
+    }
+
+    /**
+     * @brief Schedules the next attempt after a jittered backoff delay
+     * @returns {number} Delay in milliseconds
+     */
+    scheduleRetry()
+    {
+        if (this.retryTimer) return 0;
+
+        const cap = Math.min(this.maxDelay, this.baseDelay * 2 ** this.failures);
+        const delay = Math.round(Math.random() * cap);
+        this.failures++;
+
+        console.log(`Reconnecting in ${(delay / 1000).toFixed(1)}s (attempt ${this.failures})...`);
+        this.retryTimer = setTimeout(() => this.open(), delay);
+        return delay;
+    }
+
+    /**
+     * @brief Disconnects for good and cancels any pending attempt
+     */
+    stop()
+    {
+        this.stopped = true;
+        clearTimeout(this.retryTimer);
+        clearTimeout(this.attemptTimer);
+        clearTimeout(this.stableTimer);
+        this.retryTimer = null;
+
+        if (this.bot) this.bot.quit();
+    }
+
+    //* HANDLE
+
+    /**
+     * @brief Builds the stable handle forwarding to the current bot
+     * @returns {Proxy} Bot handle
+     */
+    createHandle()
+    {
+        return new Proxy({},
+        {
+            get: (target, key) =>
+            {
+                if (LISTENER_METHODS.has(key)) return this.listenerMethod(key);
+
+                const value = this.bot ? this.bot[key] : undefined;
+                if (typeof value !== 'function') return value;
+
+                // Bind once per connection so repeated calls do not allocate
+                let bound = this.bound.get(value);
+                if (!bound)
+                {
+                    bound = value.bind(this.bot);
+                    this.bound.set(value, bound);
+                }
+                return bound;
+            },
+            set: (target, key, value) =>
+            {
+                if (this.bot) this.bot[key] = value;
+                return true;
+            },
+            has: (target, key) => !!this.bot && key in this.bot
+        });
+    }
+
+    /**
+     * @brief Listener method of the handle that records persistent listeners
+     * @param {string} method - 'on', 'addListener', 'removeListener' or 'off'
+     * @returns {Function} (event, listener) => handle
+     */
+    listenerMethod(method)
+    {
+        const adding = method === 'on' || method === 'addListener';
+
+        return (event, listener) =>
+        {
+            if (adding) this.listeners.push({ event, listener });
+            else this.listeners = this.listeners.filter(entry => entry.event !== event || entry.listener !== listener);
+
+            if (this.bot) this.bot[method](event, listener);
+            return this.handle;
+        };
+    }
+}
+
+module.exports = ConnectionManager;
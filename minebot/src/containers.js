@@ -0,0 +1,379 @@
+/** *************************************************************************************
+
+    * @file        containers.js
+    * @brief       Persistent memory of container contents indexed by position and item
+    * @author      Agustín I. Galdeman
+    * @author      Ian A. Dib
+    * @author      Luciano S. Cordero
+    * @date        2025-07-03
+    * @version     1.0 - Initial container memory module
+
+    ************************************************************************************* */
+
+
+/* **************************************************************************************
+    * INCLUDES AND DEPENDENCIES *
+   ************************************************************************************** */
+
+const fs = require('fs');
+const path = require('path');
+
+
+/* **************************************************************************************
+    * CONSTANTS AND STATIC DATA *
+   ************************************************************************************** */
+
+// Default location of the persisted container database
+const DEFAULT_STORE_PATH = path.join(__dirname, '..', 'data', 'containers.json');
+
+// Delay before flushing pending changes to disk in milliseconds
+const SAVE_DELAY = 2000;
+
+// Block names that are remembered as containers
+const CONTAINER_BLOCKS = new Set(['chest', 'trapped_chest', 'barrel', 'shulker_box', 'ender_chest']);
+
+
+/* **************************************************************************************
+    * CLASS IMPLEMENTATIONS *
+   ************************************************************************************** */
+
+/**
+ * @class ContainerMemory
+ * @brief Remembers the last seen contents of every opened container
+ * @details Records are keyed by "x,y,z" and carry a timestamp. An item index maps every
+ *          item name to the containers holding it, so lookups never require walking to
+ *          and reopening a chest. Open windows are tracked through their slot updates.
+ */
+class ContainerMemory
+{
+    /**
+     * @brief Constructor loads the persisted database and tracks container removal
+     * @param {Object} bot - Mineflayer bot instance
+     * @param {string} storePath - JSON file used for persistence (default: data/containers.json)
+     */
+    constructor(bot, storePath = DEFAULT_STORE_PATH)
+    {
+        this.bot = bot;
+        this.storePath = storePath;
+
+        this.records = new Map();   // key -> { x, y, z, block, timestamp, slots }
+        this.itemIndex = new Map(); // item name -> Map(key -> count)
+        this.watched = new Map();   // window -> { key, listener }
+        this.saveTimer = null;
+
+        this.onBlockUpdate = (oldBlock, newBlock) => this.handleBlockUpdate(oldBlock, newBlock);
+        this.bot.on('blockUpdate', this.onBlockUpdate);
+
+        this.load();
+    }
+
+    //* RECORDING
+
+    /**
+     * @brief Starts tracking an open container window and stores its current contents
+     * @param {Object} block - Container block that was opened
+     * @param {Object} window - Window returned by bot.openContainer/openChest
+     */
+    watch(block, window)
+    {
+        const key = ContainerMemory.keyOf(block.position);
+        const record =
+        {
+            x: block.position.x,
+            y: block.position.y,
+            z: block.position.z,
+            block: block.name,
+            timestamp: Date.now(),
+            slots: {}
+        };
+
+        this.removeFromIndex(key);
+        this.records.set(key, record);
+
+        for (const item of window.containerItems())
+        {
+            record.slots[item.slot] = { name: item.name, count: item.count };
+            this.addToIndex(key, item.name, item.count);
+        }
+
+        const listener = (slot, oldItem, newItem) => this.updateSlot(key, window, slot, oldItem, newItem);
+        window.on('updateSlot', listener);
+        this.watched.set(window, { key, listener });
+
+        this.scheduleSave();
+    }
+
+    /**
+     * @brief Stops tracking a container window
+     * @param {Object} window - Window previously passed to watch()
+     */
+    unwatch(window)
+    {
+        const entry = this.watched.get(window);
+        if (!entry) return;
+
+        window.removeListener('updateSlot', entry.listener);
+        this.watched.delete(window);
+    }
+
+    /**
+     * @brief Drops the windows of a lost connection, keeping every stored record
+     */
+    reattach()
+    {
+        for (const window of [...this.watched.keys()]) this.unwatch(window);
+    }
+
+    /**
+     * @brief Applies a container slot change to the stored record
+     * @param {string} key - Container key
+     * @param {Object} window - Container window
+     * @param {number} slot - Window slot index
+     * @param {Object|null} oldItem - Item previously in the slot
+     * @param {Object|null} newItem - Item now in the slot
+     */
+    updateSlot(key, window, slot, oldItem, newItem)
+    {
+        // Slots past inventoryStart belong to the player inventory
+        if (slot >= window.inventoryStart) return;
+
+        const record = this.records.get(key);
+        if (!record) return;
+
+        const previous = record.slots[slot];
+        if (previous)
+        {
+            this.addToIndex(key, previous.name, -previous.count);
+            delete record.slots[slot];
+        }
+
+        if (newItem)
+        {
+            record.slots[slot] = { name: newItem.name, count: newItem.count };
+            this.addToIndex(key, newItem.name, newItem.count);
+        }
+
+        record.timestamp = Date.now();
+        this.scheduleSave();
+    }
+
+    /**
+     * @brief Forgets a container whose block was broken or replaced
+     * @param {Object|null} oldBlock - Block before the update
+     * @param {Object} newBlock - Block after the update
+     */
+    handleBlockUpdate(oldBlock, newBlock)
+    {
+        if (!newBlock || CONTAINER_BLOCKS.has(newBlock.name)) return;
+
+        const key = ContainerMemory.keyOf(newBlock.position);
+        if (this.records.has(key)) this.forget(key);
+    }
+
+    /**
+     * @brief Removes a container record
+     * @param {string} key - Container key
+     */
+    forget(key)
+    {
+        this.removeFromIndex(key);
+        this.records.delete(key);
+        this.scheduleSave();
+    }
+
+    //* ITEM INDEX
+
+    /**
+     * @brief Adjusts the indexed count of an item in a container
+     * @param {string} key - Container key
+     * @param {string} name - Item name
+     * @param {number} delta - Count change (negative to remove)
+     */
+    addToIndex(key, name, delta)
+    {
+        let holders = this.itemIndex.get(name);
+        if (!holders)
+        {
+            holders = new Map();
+            this.itemIndex.set(name, holders);
+        }
+
+        const count = (holders.get(key) || 0) + delta;
+        if (count > 0) holders.set(key, count);
+        else holders.delete(key);
+
+        if (holders.size === 0) this.itemIndex.delete(name);
+    }
+
+    /**
+     * @brief Removes every indexed item of a container
+     * @param {string} key - Container key
+     */
+    removeFromIndex(key)
+    {
+        const record = this.records.get(key);
+        if (!record) return;
+
+        for (const slot in record.slots)
+        {
+            const item = record.slots[slot];
+            this.addToIndex(key, item.name, -item.count);
+        }
+    }
+
+    //* QUERIES
+
+    /**
+     * @brief Lists the remembered containers holding an item
+     * @param {string} name - Item name (e.g. 'iron_ingot')
+     * @returns {Array} Entries with x, y, z, count and timestamp, largest count first
+     */
+    whichHas(name)
+    {
+        const holders = this.itemIndex.get(name);
+        if (!holders) return [];
+
+        const result = [];
+        for (const [key, count] of holders)
+        {
+            const record = this.records.get(key);
+            result.push({ x: record.x, y: record.y, z: record.z, count, timestamp: record.timestamp });
+        }
+
+        return result.sort((a, b) => b.count - a.count);
+    }
+
+    /**
+     * @brief Finds the closest remembered container holding an item
+     * @param {string} name - Item name
+     * @param {Object} from - Reference position with x, y, z
+     * @returns {Object|null} Closest entry or null if no container holds the item
+     */
+    nearestWith(name, from)
+    {
+        let best = null;
+        let bestDistance = Infinity;
+
+        for (const entry of this.whichHas(name))
+        {
+            const dx = entry.x - from.x, dy = entry.y - from.y, dz = entry.z - from.z;
+            const distance = dx * dx + dy * dy + dz * dz;
+            if (distance < bestDistance)
+            {
+                best = entry;
+                bestDistance = distance;
+            }
+        }
+
+        return best;
+    }
+
+    /**
+     * @brief Total remembered count of an item across all containers
+     * @param {string} name - Item name
+     * @returns {number} Item count
+     */
+    totalOf(name)
+    {
+        const holders = this.itemIndex.get(name);
+        if (!holders) return 0;
+
+        let total = 0;
+        for (const count of holders.values()) total += count;
+        return total;
+    }
+
+    /**
+     * @brief Last seen contents of a container
+     * @param {number} x - X coordinate
+     * @param {number} y - Y coordinate
+     * @param {number} z - Z coordinate
+     * @returns {Object|null} Record with items array and timestamp, or null if unknown
+     */
+    contentsAt(x, y, z)
+    {
+        const record = this.records.get(ContainerMemory.keyOf({ x, y, z }));
+        if (!record) return null;
+
+        return {
+            block: record.block,
+            timestamp: record.timestamp,
+            items: Object.keys(record.slots).map(slot => ({
+                slot: Number(slot),
+                name: record.slots[slot].name,
+                count: record.slots[slot].count
+            }))
+        };
+    }
+
+    //* PERSISTENCE
+
+    /**
+     * @brief Loads the database from disk, ignoring a missing or corrupt file
+     */
+    load()
+    {
+        let data;
+        try
+        {
+            data = JSON.parse(fs.readFileSync(this.storePath, 'utf8'));
+        }
+        catch (error)
+        {
+            if (error.code !== 'ENOENT') console.log(`Container memory not loaded: ${error.message}`);
+            return;
+        }
+
+        for (const record of data.containers || [])
+        {
+            const key = ContainerMemory.keyOf(record);
+            this.records.set(key, record);
+
+            for (const slot in record.slots)
+            {
+                const item = record.slots[slot];
+                this.addToIndex(key, item.name, item.count);
+            }
+        }
+    }
+
+    /**
+     * @brief Schedules a debounced write of the database
+     */
+    scheduleSave()
+    {
+        if (this.saveTimer) return;
+
+        this.saveTimer = setTimeout(() =>
+        {
+            this.saveTimer = null;
+            this.save().catch(error => console.log(`Container memory not saved: ${error.message}`));
+        }, SAVE_DELAY);
+    }
+
+    /**
+     * @brief Writes the database to disk atomically
+     * @returns {Promise} Promise resolving once the file is replaced
+     */
+    async save()
+    {
+        const data = JSON.stringify({ containers: [...this.records.values()] });
+        const tempPath = `${this.storePath}.tmp`;
+
+        await fs.promises.mkdir(path.dirname(this.storePath), { recursive: true });
+        await fs.promises.writeFile(tempPath, data);
+        await fs.promises.rename(tempPath, this.storePath);
+    }
+
+    /**
+     * @brief Builds the record key of a position
+     * @param {Object} pos - Position with x, y, z
+     * @returns {string} Key in "x,y,z" form
+     */
+    static keyOf(pos)
+    {
+        return `${pos.x},${pos.y},${pos.z}`;
+    }
+}
+
+module.exports = ContainerMemory;
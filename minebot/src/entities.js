@@ -0,0 +1,259 @@
+/** *************************************************************************************
+
+    * @file        entities.js
+    * @brief       Spatial hash of tracked entities with radius queries
+    * @author      Agustín I. Galdeman
+    * @author      Ian A. Dib
+    * @author      Luciano S. Cordero
+    * @date        2025-07-14
+    * @version     1.0 - Initial entity tracking module
+
+    ************************************************************************************* */
+
+
+/* **************************************************************************************
+    * CONSTANTS AND STATIC DATA *
+   ************************************************************************************** */
+
+// Edge length of a hash cell in blocks
+const CELL_SIZE = 4;
+
+// Entity types that never block movement
+const NON_BLOCKING_TYPES = new Set(['object', 'orb', 'projectile', 'global']);
+
+
+/* **************************************************************************************
+    * CLASS IMPLEMENTATIONS *
+   ************************************************************************************** */
+
+/**
+ * @class EntityGrid
+ * @brief Buckets mobs, players and items into fixed size cells refreshed from move packets
+ * @details Each entity lives in exactly one cell; a move only touches the hash when the
+ *          entity crosses a cell border. Radius queries visit the covering cells only.
+ */
+class EntityGrid
+{
+    /**
+     * @brief Constructor indexes the known entities and subscribes to entity events
+     * @param {Object} bot - Mineflayer bot instance
+     */
+    constructor(bot)
+    {
+        this.bot = bot;
+        this.cells = new Map();     // cell key -> Set of entities
+        this.cellOf = new Map();    // entity id -> cell key
+
+        this.onUpdate = (entity) => this.update(entity);
+        this.onGone = (entity) => this.remove(entity);
+
+        this.bot.on('entitySpawn', this.onUpdate);
+        this.bot.on('entityMoved', this.onUpdate);
+        this.bot.on('entityGone', this.onGone);
+
+        for (const id in bot.entities) this.update(bot.entities[id]);
+    }
+
+    //* INDEX MAINTENANCE
+
+    /**
+     * @brief Inserts an entity or moves it to its current cell
+     * @param {Object} entity - Mineflayer entity
+     */
+    update(entity)
+    {
+        if (entity === this.bot.entity || !entity.position) return;
+
+        const key = EntityGrid.cellKey(entity.position.x, entity.position.y, entity.position.z);
+        const previous = this.cellOf.get(entity.id);
+        if (previous === key) return;
+
+        if (previous !== undefined) this.removeFromCell(previous, entity);
+
+        if (!this.cells.has(key)) this.cells.set(key, new Set());
+        this.cells.get(key).add(entity);
+        this.cellOf.set(entity.id, key);
+    }
+
+    /**
+     * @brief Removes an entity from the hash
+     * @param {Object} entity - Mineflayer entity
+     */
+    remove(entity)
+    {
+        const key = this.cellOf.get(entity.id);
+        if (key === undefined) return;
+
+        this.removeFromCell(key, entity);
+        this.cellOf.delete(entity.id);
+    }
+
+    /**
+     * @brief Removes an entity from one cell, dropping the cell when empty
+     * @param {string} key - Cell key
+     * @param {Object} entity - Mineflayer entity
+     */
+    removeFromCell(key, entity)
+    {
+        const cell = this.cells.get(key);
+        if (!cell) return;
+
+        cell.delete(entity);
+        if (cell.size === 0) this.cells.delete(key);
+    }
+
+    /**
+     * @brief Re-indexes the entities of a new connection
+     */
+    reattach()
+    {
+        this.cells.clear();
+        this.cellOf.clear();
+        for (const id in this.bot.entities) this.update(this.bot.entities[id]);
+    }
+
+    /**
+     * @brief Unsubscribes the grid from entity events
+     */
+    detach()
+    {
+        this.bot.removeListener('entitySpawn', this.onUpdate);
+        this.bot.removeListener('entityMoved', this.onUpdate);
+        this.bot.removeListener('entityGone', this.onGone);
+    }
+
+    //* QUERIES
+
+    /**
+     * @brief Lists the entities within a radius of a point
+     * @param {Object} point - Centre with x, y, z
+     * @param {number} radius - Search radius in blocks
+     * @param {Function} filter - Optional predicate on entities
+     * @returns {Array} Matching entities
+     */
+    within(point, radius, filter = null)
+    {
+        const result = [];
+        const limit = radius * radius;
+
+        const min = EntityGrid.cellCoords(point.x - radius, point.y - radius, point.z - radius);
+        const max = EntityGrid.cellCoords(point.x + radius, point.y + radius, point.z + radius);
+
+        for (let cx = min.x; cx <= max.x; cx++)
+        {
+            for (let cy = min.y; cy <= max.y; cy++)
+            {
+                for (let cz = min.z; cz <= max.z; cz++)
+                {
+                    const cell = this.cells.get(`${cx},${cy},${cz}`);
+                    if (!cell) continue;
+
+                    for (const entity of cell)
+                    {
+                        const p = entity.position;
+                        const dx = p.x - point.x, dy = p.y - point.y, dz = p.z - point.z;
+                        if (dx * dx + dy * dy + dz * dz > limit) continue;
+                        if (filter && !filter(entity)) continue;
+                        result.push(entity);
+                    }
+                }
+            }
+        }
+
+        return result;
+    }
+
+    /**
+     * @brief Finds the closest entity within a radius
+     * @param {Object} point - Centre with x, y, z
+     * @param {number} radius - Search radius in blocks
+     * @param {Function} filter - Optional predicate on entities
+     * @returns {Object|null} Closest matching entity or null
+     */
+    nearest(point, radius, filter = null)
+    {
+        let best = null;
+        let bestDistance = Infinity;
+
+        for (const entity of this.within(point, radius, filter))
+        {
+            const p = entity.position;
+            const distance = (p.x - point.x) ** 2 + (p.y - point.y) ** 2 + (p.z - point.z) ** 2;
+            if (distance < bestDistance)
+            {
+                best = entity;
+                bestDistance = distance;
+            }
+        }
+
+        return best;
+    }
+
+    /**
+     * @brief Finds an entity occupying a block column cell (feet or head level)
+     * @param {number} x - Block X coordinate
+     * @param {number} y - Block Y coordinate of the feet
+     * @param {number} z - Block Z coordinate
+     * @returns {Object|null} Blocking entity or null if the cell is free
+     */
+    blockerAt(x, y, z)
+    {
+        const centre = { x: x + 0.5, y: y + 1, z: z + 0.5 };
+
+        for (const entity of this.within(centre, 2, EntityGrid.isBlocking))
+        {
+            const p = entity.position;
+            // Entity half width plus the bot's own half width and a small margin
+            const reach = (entity.width || 0.6) / 2 + 0.5;
+            if (Math.abs(p.x - centre.x) < reach && Math.abs(p.z - centre.z) < reach &&
+                p.y < y + 2 && p.y + (entity.height || 1.8) > y)
+            {
+                return entity;
+            }
+        }
+
+        return null;
+    }
+
+    //* HELPERS
+
+    /**
+     * @brief Checks whether an entity physically blocks movement
+     * @param {Object} entity - Mineflayer entity
+     * @returns {boolean} True for players and mobs
+     */
+    static isBlocking(entity)
+    {
+        return entity.name !== 'item' && !NON_BLOCKING_TYPES.has(entity.type);
+    }
+
+    /**
+     * @brief Converts world coordinates into cell coordinates
+     * @param {number} x - X coordinate
+     * @param {number} y - Y coordinate
+     * @param {number} z - Z coordinate
+     * @returns {Object} Cell coordinates
+     */
+    static cellCoords(x, y, z)
+    {
+        return {
+            x: Math.floor(x / CELL_SIZE),
+            y: Math.floor(y / CELL_SIZE),
+            z: Math.floor(z / CELL_SIZE)
+        };
+    }
+
+    /**
+     * @brief Builds the cell key of a position
+     * @param {number} x - X coordinate
+     * @param {number} y - Y coordinate
+     * @param {number} z - Z coordinate
+     * @returns {string} Cell key
+     */
+    static cellKey(x, y, z)
+    {
+        return `${Math.floor(x / CELL_SIZE)},${Math.floor(y / CELL_SIZE)},${Math.floor(z / CELL_SIZE)}`;
+    }
+}
+
+module.exports = EntityGrid;
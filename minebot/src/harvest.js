@@ -0,0 +1,295 @@
+/** *************************************************************************************
+
+    * @file        harvest.js
+    * @brief       Tree felling routine with standing spot planning and reach ordered digs
+    * @author      Agustín I. Galdeman
+    * @author      Ian A. Dib
+    * @author      Luciano S. Cordero
+    * @date        2025-07-11
+    * @version     1.0 - Initial tree harvesting module
+
+    ************************************************************************************* */
+
+
+/* **************************************************************************************
+    * INCLUDES AND DEPENDENCIES *
+   ************************************************************************************** */
+
+const { Vec3 } = require('vec3');
+
+
+/* **************************************************************************************
+    * CONSTANTS AND STATIC DATA *
+   ************************************************************************************** */
+
+// Default harvesting parameters
+const HARVEST_DEFAULTS = { trees: 1, radius: 32, naive: false };
+
+// Maximum number of logs attributed to a single tree
+const MAX_TREE_LOGS = 64;
+
+// Horizontal radius around the trunk searched for standing spots
+const STAND_RADIUS = 3;
+
+// Interaction reach and eye height used when scoring standing spots
+const REACH = 4.5;
+const EYE_HEIGHT = 1.62;
+
+// Nether stems and wood blocks counted as logs; other '_stem' blocks are plants
+const NETHER_STEMS = new Set([
+    'crimson_stem', 'warped_stem', 'stripped_crimson_stem', 'stripped_warped_stem',
+    'crimson_hyphae', 'warped_hyphae', 'stripped_crimson_hyphae', 'stripped_warped_hyphae'
+]);
+
+
+/* **************************************************************************************
+    * CLASS IMPLEMENTATIONS *
+   ************************************************************************************** */
+
+/**
+ * @class TreeHarvester
+ * @brief Finds trees through the block index and fells them from the best standing spot
+ * @details For each tree the connected logs are collected, every free ground cell near
+ *          the trunk is scored by how many logs it reaches, and the logs reachable from
+ *          the winner are dug nearest-to-the-eyes first as one batch. The naive mode
+ *          walks next to every log before digging it and exists for comparison.
+ */
+class TreeHarvester
+{
+    /**
+     * @brief Constructor initializes the harvester
+     * @param {Object} bot - Mineflayer bot instance
+     * @param {Object} actions - BotActions instance used to dig
+     * @param {Object} blocks - BlockIndex instance used to find logs
+     * @param {Object} mining - MiningEngine instance used for walking and batched digs
+     */
+    constructor(bot, actions, blocks, mining)
+    {
+        this.bot = bot;
+        this.actions = actions;
+        this.blocks = blocks;
+        this.mining = mining;
+        this.stats = { logs: 0, trees: 0, startTime: Date.now() };
+    }
+
+    //* HARVESTING
+
+    /**
+     * @brief Fells a number of nearby trees
+     * @param {Object} options - { trees, radius, naive } overriding HARVEST_DEFAULTS, plus an
+     *                          optional AbortSignal as signal
+     * @returns {Object} Report with trees, logs, seconds and logs per minute
+     * @throws {Error} AbortError when cancelled
+     */
+    async run(options = {})
+    {
+        const settings = Object.assign({}, HARVEST_DEFAULTS, options);
+        this.stats = { logs: 0, trees: 0, startTime: Date.now() };
+
+        // Digs and steps run through the mining executor, which carries the signal
+        this.mining.signal = settings.signal || null;
+
+        for (let i = 0; i < settings.trees; i++)
+        {
+            const eye = this.bot.entity.position.offset(0, EYE_HEIGHT, 0);
+            const seed = this.blocks.nearest(TreeHarvester.isLog, eye, settings.radius);
+            if (!seed) break;
+
+            const logs = this.collectTree(seed);
+            if (settings.naive) await this.fellNaive(logs);
+            else await this.fell(logs);
+
+            this.stats.trees++;
+        }
+
+        return this.report(settings.naive);
+    }
+
+    /**
+     * @brief Fells one tree from its best standing spot
+     * @param {Array} logs - Log positions of the tree
+     */
+    async fell(logs)
+    {
+        const stand = this.chooseStand(logs);
+        if (stand) await this.mining.approach(stand, 0);
+
+        const eye = this.bot.entity.position.offset(0, EYE_HEIGHT, 0);
+        const ordered = logs.slice().sort((a, b) =>
+            TreeHarvester.distanceSq(eye, a) - TreeHarvester.distanceSq(eye, b));
+
+        await this.digLogs(ordered);
+
+        // Drops land around the trunk base
+        if (this.mining.collector)
+        {
+            await this.mining.collectDrops();
+        }
+        else
+        {
+            const base = logs.reduce((low, log) => (log.y < low.y ? log : low));
+            await this.mining.approach(base, 0);
+        }
+    }
+
+    /**
+     * @brief Fells one tree by walking next to every log before digging it
+     * @param {Array} logs - Log positions of the tree
+     */
+    async fellNaive(logs)
+    {
+        for (const log of logs)
+        {
+            await this.mining.approach(log, 1);
+            await this.digLogs([log]);
+        }
+    }
+
+    /**
+     * @brief Digs logs through the mining executor and counts the ones removed
+     * @param {Array} logs - Log positions in dig order
+     */
+    async digLogs(logs)
+    {
+        await this.mining.digPositions(logs, true);
+
+        for (const log of logs)
+        {
+            const block = this.bot.blockAt(new Vec3(log.x, log.y, log.z));
+            if (!block || !TreeHarvester.isLog(block.name)) this.stats.logs++;
+        }
+    }
+
+    //* PLANNING
+
+    /**
+     * @brief Collects the logs connected to a seed log, including diagonal branches
+     * @param {Object} seed - Log position with name
+     * @returns {Array} Log positions
+     */
+    collectTree(seed)
+    {
+        const seen = new Set([`${seed.x},${seed.y},${seed.z}`]);
+        const queue = [{ x: seed.x, y: seed.y, z: seed.z }];
+        const logs = [];
+
+        while (queue.length > 0 && logs.length < MAX_TREE_LOGS)
+        {
+            const pos = queue.shift();
+            logs.push(pos);
+
+            for (let dx = -1; dx <= 1; dx++)
+            {
+                for (let dy = -1; dy <= 1; dy++)
+                {
+                    for (let dz = -1; dz <= 1; dz++)
+                    {
+                        const next = { x: pos.x + dx, y: pos.y + dy, z: pos.z + dz };
+                        const key = `${next.x},${next.y},${next.z}`;
+                        if (seen.has(key)) continue;
+                        seen.add(key);
+
+                        const name = this.blocks.nameAt(next);
+                        if (name && TreeHarvester.isLog(name)) queue.push(next);
+                    }
+                }
+            }
+        }
+
+        return logs;
+    }
+
+    /**
+     * @brief Picks the ground cell near the trunk that reaches the most logs
+     * @param {Array} logs - Log positions of the tree
+     * @returns {Object|null} Standing position (feet), or null if none is free
+     */
+    chooseStand(logs)
+    {
+        const base = logs.reduce((low, log) => (log.y < low.y ? log : low));
+        const from = this.actions.position();
+        let best = null;
+
+        for (let dx = -STAND_RADIUS; dx <= STAND_RADIUS; dx++)
+        {
+            for (let dz = -STAND_RADIUS; dz <= STAND_RADIUS; dz++)
+            {
+                const stand = { x: base.x + dx, y: base.y, z: base.z + dz };
+                if (!this.isStandable(stand)) continue;
+
+                const eye = { x: stand.x, y: stand.y + EYE_HEIGHT - 0.5, z: stand.z };
+                const reached = logs.filter(log => TreeHarvester.distanceSq(eye, log) <= REACH * REACH).length;
+                const walk = Math.abs(stand.x - from.x) + Math.abs(stand.z - from.z);
+
+                if (!best || reached > best.reached || (reached === best.reached && walk < best.walk))
+                {
+                    best = { stand, reached, walk };
+                }
+            }
+        }
+
+        return best ? best.stand : null;
+    }
+
+    /**
+     * @brief Checks whether the bot can stand on a cell
+     * @param {Object} pos - Feet position
+     * @returns {boolean} True if feet and head are free and the floor is solid
+     */
+    isStandable(pos)
+    {
+        const feet = this.bot.blockAt(new Vec3(pos.x, pos.y, pos.z));
+        const head = this.bot.blockAt(new Vec3(pos.x, pos.y + 1, pos.z));
+        const floor = this.bot.blockAt(new Vec3(pos.x, pos.y - 1, pos.z));
+
+        return !!feet && !!head && !!floor &&
+            this.actions.isPassable(feet) && this.actions.isPassable(head) && floor.boundingBox === 'block';
+    }
+
+    //* REPORTING
+
+    /**
+     * @brief Builds the report of the current run
+     * @param {boolean} naive - Whether the naive mode was used
+     * @returns {Object} Trees, logs, seconds and logs per minute
+     */
+    report(naive)
+    {
+        const seconds = (Date.now() - this.stats.startTime) / 1000;
+        return {
+            mode: naive ? 'naive' : 'planned',
+            trees: this.stats.trees,
+            logs: this.stats.logs,
+            seconds: Math.round(seconds),
+            logsPerMinute: seconds > 0 ? (this.stats.logs * 60) / seconds : 0
+        };
+    }
+
+    //* HELPERS
+
+    /**
+     * @brief Checks whether a block name is a log, wood block or nether stem
+     * @details Pumpkin, melon and mushroom stems also end in '_stem', so nether stems
+     *          are matched by name.
+     * @param {string} name - Block name
+     * @returns {boolean} True for logs, wood and nether stems
+     */
+    static isLog(name)
+    {
+        return name.endsWith('_log') || name.endsWith('_wood') || NETHER_STEMS.has(name);
+    }
+
+    /**
+     * @brief Squared distance from a point to a block centre
+     * @param {Object} point - Point with x, y, z (block coordinates of the eye cell)
+     * @param {Object} block - Block position
+     * @returns {number} Squared distance
+     */
+    static distanceSq(point, block)
+    {
+        const dx = block.x - point.x, dy = block.y - point.y, dz = block.z - point.z;
+        return dx * dx + dy * dy + dz * dz;
+    }
+}
+
+module.exports = TreeHarvester;
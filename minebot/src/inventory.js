@@ -0,0 +1,411 @@
+/** *************************************************************************************
+
+    * @file        inventory.js
+    * @brief       Incremental inventory index with constant time item queries
+    * @author      Agustín I. Galdeman
+    * @author      Ian A. Dib
+    * @author      Luciano S. Cordero
+    * @date        2025-07-02
+    * @version     1.0 - Initial inventory index module
+
+    ************************************************************************************* */
+
+
+/* **************************************************************************************
+    * INCLUDES AND DEPENDENCIES *
+   ************************************************************************************** */
+
+const EventEmitter = require('events');
+
+
+/* **************************************************************************************
+    * CONSTANTS AND STATIC DATA *
+   ************************************************************************************** */
+
+// Item name suffixes mapped to the tag they are indexed under
+const TAG_SUFFIXES =
+{
+    _pickaxe: 'pickaxe',
+    _axe: 'axe',
+    _shovel: 'shovel',
+    _hoe: 'hoe',
+    _sword: 'sword',
+    _log: 'log',
+    _wood: 'log',
+    _planks: 'planks',
+    _ore: 'ore',
+    _ingot: 'ingot'
+};
+
+// Exact item names mapped to the tag they are indexed under
+const TAG_NAMES =
+{
+    shears: 'shears',
+    cobblestone: 'building',
+    cobbled_deepslate: 'building',
+    stone: 'building',
+    dirt: 'building',
+    netherrack: 'building'
+};
+
+// Tags that count as tools when checking for durability
+const TOOL_TAGS = ['pickaxe', 'axe', 'shovel', 'hoe', 'sword', 'shears'];
+
+
+/* **************************************************************************************
+    * CLASS IMPLEMENTATIONS *
+   ************************************************************************************** */
+
+/**
+ * @class InventoryIndex
+ * @brief Keeps per item, per tag and free slot bookkeeping in sync with the bot inventory
+ * @details The index is rebuilt once and then patched from window slot updates, so every
+ *          query is a map lookup instead of a scan over bot.inventory.items(). Emits a
+ *          'change' event with (name, delta) whenever an item count changes.
+ */
+class InventoryIndex extends EventEmitter
+{
+    /**
+     * @brief Constructor builds the index and subscribes to inventory updates
+     * @param {Object} bot - Mineflayer bot instance
+     */
+    constructor(bot)
+    {
+        super();
+        this.bot = bot;
+
+        this.byName = new Map(); // name -> { type, count, slots }
+        this.byId = new Map();   // item id -> same entry as byName
+        this.byTag = new Map();  // tag -> { count, slots }
+        this.freeSlots = new Set();
+        this.tagCache = new Map();
+
+        this.onUpdateSlot = (slot, oldItem, newItem) => this.updateSlot(slot, oldItem, newItem);
+        this.onWindowClose = () => this.rebuild();
+
+        this.window = this.bot.inventory;
+        this.window.on('updateSlot', this.onUpdateSlot);
+        this.bot.on('windowClose', this.onWindowClose);
+
+        this.rebuild();
+    }
+
+    //* INDEX MAINTENANCE
+
+    /**
+     * @brief Rebuilds the whole index from the current inventory window
+     */
+    rebuild()
+    {
+        const inventory = this.bot.inventory;
+
+        this.byName.clear();
+        this.byId.clear();
+        this.byTag.clear();
+        this.freeSlots.clear();
+
+        for (let slot = inventory.inventoryStart; slot < inventory.inventoryEnd; slot++)
+        {
+            const item = inventory.slots[slot];
+            if (item) this.addItem(slot, item);
+            else this.freeSlots.add(slot);
+        }
+    }
+
+    /**
+     * @brief Applies a single slot change reported by the inventory window
+     * @param {number} slot - Window slot index that changed
+     * @param {Object|null} oldItem - Item previously in the slot
+     * @param {Object|null} newItem - Item now in the slot
+     */
+    updateSlot(slot, oldItem, newItem)
+    {
+        const inventory = this.bot.inventory;
+        if (slot < inventory.inventoryStart || slot >= inventory.inventoryEnd) return;
+
+        if (oldItem)
+        {
+            this.removeItem(slot, oldItem);
+            this.emit('change', oldItem.name, -oldItem.count);
+        }
+
+        if (newItem)
+        {
+            this.addItem(slot, newItem);
+            this.emit('change', newItem.name, newItem.count);
+        }
+        else
+        {
+            this.freeSlots.add(slot);
+        }
+    }
+
+    /**
+     * @brief Adds an item stack to the name, id and tag entries
+     * @param {number} slot - Slot holding the stack
+     * @param {Object} item - Item stack
+     */
+    addItem(slot, item)
+    {
+        let entry = this.byName.get(item.name);
+        if (!entry)
+        {
+            entry = { type: item.type, count: 0, slots: new Set() };
+            this.byName.set(item.name, entry);
+            this.byId.set(item.type, entry);
+        }
+        entry.count += item.count;
+        entry.slots.add(slot);
+
+        for (const tag of this.tagsOf(item.name))
+        {
+            let tagEntry = this.byTag.get(tag);
+            if (!tagEntry)
+            {
+                tagEntry = { count: 0, slots: new Set() };
+                this.byTag.set(tag, tagEntry);
+            }
+            tagEntry.count += item.count;
+            tagEntry.slots.add(slot);
+        }
+
+        this.freeSlots.delete(slot);
+    }
+
+    /**
+     * @brief Removes an item stack from the name, id and tag entries
+     * @param {number} slot - Slot that held the stack
+     * @param {Object} item - Item stack previously in the slot
+     */
+    removeItem(slot, item)
+    {
+        const entry = this.byName.get(item.name);
+        if (entry)
+        {
+            entry.count -= item.count;
+            entry.slots.delete(slot);
+            if (entry.slots.size === 0)
+            {
+                this.byName.delete(item.name);
+                this.byId.delete(entry.type);
+            }
+        }
+
+        for (const tag of this.tagsOf(item.name))
+        {
+            const tagEntry = this.byTag.get(tag);
+            if (!tagEntry) continue;
+
+            tagEntry.count -= item.count;
+            tagEntry.slots.delete(slot);
+            if (tagEntry.slots.size === 0) this.byTag.delete(tag);
+        }
+    }
+
+    /**
+     * @brief Resolves the tags of an item name, memoised per name
+     * @param {string} name - Item name
+     * @returns {Array<string>} Tags the item is indexed under
+     */
+    tagsOf(name)
+    {
+        let tags = this.tagCache.get(name);
+        if (tags) return tags;
+
+        tags = [];
+        if (TAG_NAMES[name]) tags.push(TAG_NAMES[name]);
+
+        for (const suffix in TAG_SUFFIXES)
+        {
+            if (name.endsWith(suffix)) tags.push(TAG_SUFFIXES[suffix]);
+        }
+
+        this.tagCache.set(name, tags);
+        return tags;
+    }
+
+    /**
+     * @brief Follows the inventory window of a new connection and rebuilds the index
+     * @details The tag cache only depends on item names and is kept.
+     */
+    reattach()
+    {
+        this.window.removeListener('updateSlot', this.onUpdateSlot);
+        this.window = this.bot.inventory;
+        this.window.on('updateSlot', this.onUpdateSlot);
+        this.rebuild();
+    }
+
+    /**
+     * @brief Unsubscribes the index from inventory events
+     */
+    detach()
+    {
+        this.window.removeListener('updateSlot', this.onUpdateSlot);
+        this.bot.removeListener('windowClose', this.onWindowClose);
+    }
+
+    //* ITEM QUERIES
+
+    /**
+     * @brief Total number of items with the given name
+     * @param {string} name - Item name (e.g. 'cobblestone')
+     * @returns {number} Item count, 0 if absent
+     */
+    count(name)
+    {
+        const entry = this.byName.get(name);
+        return entry ? entry.count : 0;
+    }
+
+    /**
+     * @brief Total number of items with the given numeric item id
+     * @param {number} id - Item id from minecraft-data
+     * @returns {number} Item count, 0 if absent
+     */
+    countById(id)
+    {
+        const entry = this.byId.get(id);
+        return entry ? entry.count : 0;
+    }
+
+    /**
+     * @brief Total number of items carrying the given tag
+     * @param {string} tag - Tag name (e.g. 'pickaxe', 'log', 'building')
+     * @returns {number} Item count, 0 if absent
+     */
+    countTag(tag)
+    {
+        const entry = this.byTag.get(tag);
+        return entry ? entry.count : 0;
+    }
+
+    /**
+     * @brief Checks whether at least a number of items with the given name are held
+     * @param {string} name - Item name
+     * @param {number} amount - Minimum count (default: 1)
+     * @returns {boolean} True if the inventory holds enough items
+     */
+    has(name, amount = 1)
+    {
+        return this.count(name) >= amount;
+    }
+
+    /**
+     * @brief Checks whether any item with the given tag is held
+     * @param {string} tag - Tag name
+     * @returns {boolean} True if at least one tagged item is held
+     */
+    hasTag(tag)
+    {
+        return this.byTag.has(tag);
+    }
+
+    /**
+     * @brief Slots holding items with the given name
+     * @param {string} name - Item name
+     * @returns {Set<number>} Live slot set, must not be modified by the caller
+     */
+    slotsOf(name)
+    {
+        const entry = this.byName.get(name);
+        return entry ? entry.slots : new Set();
+    }
+
+    /**
+     * @brief Slots holding items with the given tag
+     * @param {string} tag - Tag name
+     * @returns {Set<number>} Live slot set, must not be modified by the caller
+     */
+    slotsOfTag(tag)
+    {
+        const entry = this.byTag.get(tag);
+        return entry ? entry.slots : new Set();
+    }
+
+    /**
+     * @brief Item stack stored in a slot
+     * @param {number} slot - Window slot index
+     * @returns {Object|null} Item stack or null if the slot is empty
+     */
+    itemAt(slot)
+    {
+        return this.bot.inventory.slots[slot] || null;
+    }
+
+    /**
+     * @brief Durability information of the item stored in a slot
+     * @param {number} slot - Window slot index
+     * @returns {Object|null} Object with used, max and remaining, or null if not damageable
+     */
+    durability(slot)
+    {
+        const item = this.itemAt(slot);
+        if (!item || !item.maxDurability) return null;
+
+        const used = item.durabilityUsed || 0;
+        return {
+            used: used,
+            max: item.maxDurability,
+            remaining: item.maxDurability - used
+        };
+    }
+
+    /**
+     * @brief Finds the tool with the most remaining durability for a tag
+     * @param {string} tag - Tool tag (pickaxe, axe, shovel, hoe, sword, shears)
+     * @returns {Object|null} Item stack of the best tool or null if none is held
+     */
+    bestTool(tag)
+    {
+        if (!TOOL_TAGS.includes(tag)) return null;
+
+        let best = null;
+        let bestRemaining = -1;
+
+        for (const slot of this.slotsOfTag(tag))
+        {
+            const info = this.durability(slot);
+            const remaining = info ? info.remaining : Infinity;
+            if (remaining > bestRemaining)
+            {
+                best = this.itemAt(slot);
+                bestRemaining = remaining;
+            }
+        }
+
+        return best;
+    }
+
+    //* FREE SLOT QUERIES
+
+    /**
+     * @brief Number of empty storage slots (main inventory and hotbar)
+     * @returns {number} Free slot count
+     */
+    freeSlotCount()
+    {
+        return this.freeSlots.size;
+    }
+
+    /**
+     * @brief Checks whether at least one storage slot is empty
+     * @returns {boolean} True if a free slot exists
+     */
+    hasFreeSlot()
+    {
+        return this.freeSlots.size > 0;
+    }
+
+    /**
+     * @brief Returns any empty storage slot
+     * @returns {number|null} Slot index or null if the inventory is full
+     */
+    firstFreeSlot()
+    {
+        for (const slot of this.freeSlots) return slot;
+        return null;
+    }
+}
+
+module.exports = InventoryIndex;
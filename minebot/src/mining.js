@@ -0,0 +1,628 @@
+/** *************************************************************************************
+
+    * @file        mining.js
+    * @brief       Mining engine with vein, strip, branch and quarry modes
+    * @author      Agustín I. Galdeman
+    * @author      Ian A. Dib
+    * @author      Luciano S. Cordero
+    * @date        2025-07-09
+    * @version     1.0 - Initial mining engine module
+
+    ************************************************************************************* */
+
+
+/* **************************************************************************************
+    * INCLUDES AND DEPENDENCIES *
+   ************************************************************************************** */
+
+const { Vec3 } = require('vec3');
+
+
+/* **************************************************************************************
+    * CONSTANTS AND STATIC DATA *
+   ************************************************************************************** */
+
+// Direction offsets used to lay out tunnels
+const DIRECTION_OFFSETS =
+{
+    north: { x: 0, z: -1 },
+    south: { x: 0, z: 1 },
+    west: { x: -1, z: 0 },
+    east: { x: 1, z: 0 }
+};
+
+// Side directions of each tunnel direction (left, right)
+const SIDE_DIRECTIONS =
+{
+    north: ['west', 'east'],
+    south: ['east', 'west'],
+    west: ['south', 'north'],
+    east: ['north', 'south']
+};
+
+// Face neighbours visited when flooding a vein or checking tunnel walls
+const FACE_OFFSETS = [
+    { x: 1, y: 0, z: 0 }, { x: -1, y: 0, z: 0 },
+    { x: 0, y: 1, z: 0 }, { x: 0, y: -1, z: 0 },
+    { x: 0, y: 0, z: 1 }, { x: 0, y: 0, z: -1 }
+];
+
+// Default parameters per mining mode
+const MODE_DEFAULTS =
+{
+    vein: { radius: 32, limit: 64 },
+    strip: { direction: 'east', length: 32 },
+    branch: { direction: 'east', length: 32, spacing: 3, branchLength: 8 },
+    quarry: { width: 5, length: 5, depth: 5 }
+};
+
+// Blocks the engine never digs
+const UNBREAKABLE = new Set(['air', 'cave_air', 'void_air', 'bedrock', 'water', 'lava']);
+
+// Maximum moves spent approaching a single target
+const MAX_APPROACH_MOVES = 24;
+
+// Deepest drop the engine may step off or dig the bot into, in blocks
+const MAX_DROP = 2;
+
+
+/* **************************************************************************************
+    * CLASS IMPLEMENTATIONS *
+   ************************************************************************************** */
+
+/**
+ * @class MiningEngine
+ * @brief Plans dig orders for several mining modes and runs them through BotActions
+ * @details Every mode produces positions in an order that keeps walking short; the
+ *          executor digs everything in reach as one batch (so BotActions can group
+ *          digs by tool) before moving on. Ores exposed in tunnel walls are followed
+ *          as veins using the block index.
+ *
+ *          Strip, branch and quarry runs are laid out from a fixed origin and record how
+ *          far they got in a progress object, so a run stopped by a preemption or a
+ *          restart picks up where it left off when given the same origin and progress.
+ */
+class MiningEngine
+{
+    /**
+     * @brief Constructor initializes the engine
+     * @param {Object} bot - Mineflayer bot instance
+     * @param {Object} actions - BotActions instance used to dig and move
+     * @param {Object} blocks - BlockIndex instance used to target ores
+     * @param {Object} collector - DropCollector instance picking up drops (optional)
+     */
+    constructor(bot, actions, blocks, collector = null)
+    {
+        this.bot = bot;
+        this.actions = actions;
+        this.blocks = blocks;
+        this.collector = collector;
+        this.signal = null; // AbortSignal of the running job
+        this.resetReport(null);
+    }
+
+    //* MODE DISPATCH
+
+    /**
+     * @brief Runs a mining mode to completion
+     * @param {string} mode - One of vein, strip, branch, quarry
+     * @param {Object} options - Mode parameters overriding MODE_DEFAULTS, plus optional
+     *                          origin (default: the bot's position), progress
+     *                          { done, blocks, ores } updated as the run advances, and
+     *                          AbortSignal as signal
+     * @returns {Object} Report with blocks, ores and ores per minute
+     * @throws {Error} If the mode is unknown, or AbortError when cancelled
+     */
+    async run(mode, options = {})
+    {
+        if (!MODE_DEFAULTS[mode]) throw new Error(`Invalid mining mode: ${mode}`);
+
+        const settings = Object.assign({}, MODE_DEFAULTS[mode], options);
+        settings.origin = settings.origin || this.actions.position();
+        settings.progress = settings.progress || { done: 0, blocks: 0, ores: 0 };
+        this.signal = settings.signal || null;
+
+        // Counters carry over from the interrupted part of the run
+        this.resetReport(mode);
+        this.stats.blocks = settings.progress.blocks;
+        this.stats.ores = settings.progress.ores;
+
+        switch (mode)
+        {
+            case 'vein':
+                await this.mineNearestVein(settings);
+                break;
+
+            case 'strip':
+                await this.mineStrip(settings);
+                break;
+
+            case 'branch':
+                await this.mineBranches(settings);
+                break;
+
+            case 'quarry':
+                await this.mineQuarry(settings);
+                break;
+        }
+
+        await this.collectDrops();
+        return this.report();
+    }
+
+    //* MODE PLANNING
+
+    /**
+     * @brief Mines the whole vein of the nearest indexed ore
+     * @param {Object} settings - { radius, limit }
+     */
+    async mineNearestVein(settings)
+    {
+        const eye = this.bot.entity.position.offset(0, 1.62, 0);
+        const target = this.blocks.nearest(MiningEngine.isOre, eye, settings.radius);
+
+        if (!target)
+        {
+            console.log('No ore in range');
+            return;
+        }
+
+        await this.mineVeinAt(target, settings.limit);
+    }
+
+    /**
+     * @brief Floods a vein from one ore block and digs it nearest first
+     * @param {Object} start - Ore position
+     * @param {number} limit - Maximum vein size (default: 64)
+     */
+    async mineVeinAt(start, limit = MODE_DEFAULTS.vein.limit)
+    {
+        const vein = this.floodVein(start, limit);
+        console.log(`Mining vein of ${vein.length} ${MiningEngine.familyOf(start.name)}`);
+        await this.digPositions(MiningEngine.nearestFirst(this.actions.position(), vein), false);
+        await this.collectDrops();
+    }
+
+    /**
+     * @brief Collects the connected blocks of the same ore family
+     * @param {Object} start - Ore position with name
+     * @param {number} limit - Maximum number of blocks
+     * @returns {Array} Vein positions with names
+     */
+    floodVein(start, limit)
+    {
+        const family = MiningEngine.familyOf(start.name);
+        const seen = new Set([`${start.x},${start.y},${start.z}`]);
+        const queue = [{ x: start.x, y: start.y, z: start.z, name: start.name }];
+        const vein = [];
+
+        while (queue.length > 0 && vein.length < limit)
+        {
+            const pos = queue.shift();
+            vein.push(pos);
+
+            for (const offset of FACE_OFFSETS)
+            {
+                const next = { x: pos.x + offset.x, y: pos.y + offset.y, z: pos.z + offset.z };
+                const key = `${next.x},${next.y},${next.z}`;
+                if (seen.has(key)) continue;
+                seen.add(key);
+
+                const name = this.blocks.nameAt(next);
+                if (name && MiningEngine.familyOf(name) === family)
+                {
+                    next.name = name;
+                    queue.push(next);
+                }
+            }
+        }
+
+        return vein;
+    }
+
+    /**
+     * @brief Digs a straight tunnel from the origin, one slice of progress at a time
+     * @param {Object} settings - { direction, length, origin, progress }
+     */
+    async mineStrip(settings)
+    {
+        const { origin, progress } = settings;
+
+        for (let done = progress.done; done < settings.length; done++)
+        {
+            const start = MiningEngine.alongTunnel(origin, settings.direction, done);
+            if (!await this.tunnel(start, settings.direction, 1)) return;
+            this.markProgress(progress, done + 1);
+        }
+    }
+
+    /**
+     * @brief Digs a main tunnel with side branches every few blocks
+     * @details Progress counts the main tunnel blocks whose junction branches are finished.
+     * @param {Object} settings - { direction, length, spacing, branchLength, origin, progress }
+     */
+    async mineBranches(settings)
+    {
+        const [left, right] = SIDE_DIRECTIONS[settings.direction];
+        const { origin, progress } = settings;
+
+        for (let done = progress.done; done < settings.length; done += settings.spacing)
+        {
+            const segment = Math.min(settings.spacing, settings.length - done);
+            const start = MiningEngine.alongTunnel(origin, settings.direction, done);
+            await this.tunnel(start, settings.direction, segment);
+
+            // Branch both sides from the junction, returning to it after each branch
+            const junction = MiningEngine.alongTunnel(origin, settings.direction, done + segment);
+
+            for (const side of [left, right])
+            {
+                await this.tunnel(junction, side, settings.branchLength);
+                await this.approach(junction, 0);
+            }
+
+            this.markProgress(progress, done + segment);
+        }
+    }
+
+    /**
+     * @brief Clears a rectangular area layer by layer in serpentine order
+     * @details Progress counts finished layers below the origin.
+     * @param {Object} settings - { width, length, depth, origin, progress }
+     */
+    async mineQuarry(settings)
+    {
+        const { origin, progress } = settings;
+
+        for (let layer = progress.done + 1; layer <= settings.depth; layer++)
+        {
+            const positions = [];
+            for (let row = 0; row < settings.length; row++)
+            {
+                for (let col = 0; col < settings.width; col++)
+                {
+                    // Serpentine rows so consecutive digs stay adjacent
+                    const x = row % 2 === 0 ? col : settings.width - 1 - col;
+                    positions.push({ x: origin.x + x, y: origin.y - layer, z: origin.z + row });
+                }
+            }
+
+            await this.digPositions(positions, true);
+            this.markProgress(progress, layer);
+        }
+    }
+
+    /**
+     * @brief Digs a two block high tunnel and follows ores exposed in its walls
+     * @param {Object} start - Tunnel start position (the bot's feet)
+     * @param {string} direction - Cardinal direction
+     * @param {number} length - Number of blocks to advance
+     * @returns {boolean} True if the whole length was dug and walked
+     */
+    async tunnel(start, direction, length)
+    {
+        const offset = DIRECTION_OFFSETS[direction];
+
+        for (let i = 1; i <= length; i++)
+        {
+            const x = start.x + offset.x * i;
+            const z = start.z + offset.z * i;
+            const slice = [{ x, y: start.y + 1, z }, { x, y: start.y, z }];
+
+            if (!await this.digPositions(slice, true)) return false;
+
+            for (const cell of slice)
+            {
+                const ore = this.exposedOre(cell);
+                if (ore) await this.mineVeinAt(ore);
+            }
+
+            if (!await this.approach({ x, y: start.y, z }, 0)) return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Finds an indexed ore touching a tunnel cell
+     * @param {Object} cell - Tunnel cell position
+     * @returns {Object|null} Ore position with name, or null
+     */
+    exposedOre(cell)
+    {
+        for (const offset of FACE_OFFSETS)
+        {
+            const pos = { x: cell.x + offset.x, y: cell.y + offset.y, z: cell.z + offset.z };
+            const name = this.blocks.nameAt(pos);
+            if (name && MiningEngine.isOre(name)) return Object.assign(pos, { name });
+        }
+        return null;
+    }
+
+    //* EXECUTION
+
+    /**
+     * @brief Digs positions, batching whatever is in reach and walking toward the rest
+     * @param {Array} positions - Block positions in planned order
+     * @param {boolean} ordered - Whether the order must be preserved
+     * @returns {boolean} True if every diggable position was cleared; false if one was
+     *                    left because digging it was unsafe or could not be reached
+     */
+    async digPositions(positions, ordered)
+    {
+        let remaining = positions.filter(pos => this.isDiggable(pos));
+        let moves = 0;
+        let skipped = false;
+
+        while (remaining.length > 0)
+        {
+            // Safety depends on where the bot stands, so it is checked before every batch
+            const safe = remaining.filter(pos => this.isSafeToDig(pos));
+            skipped = skipped || safe.length < remaining.length;
+            remaining = safe;
+            if (remaining.length === 0) break;
+
+            const reachable = remaining.filter(pos => this.actions.canReach(pos.x, pos.y, pos.z));
+
+            if (reachable.length > 0)
+            {
+                const names = reachable.map(pos => this.actions.block_at(pos.x, pos.y, pos.z).name);
+                await this.actions.dig_blocks(reachable, ordered, { signal: this.signal });
+
+                reachable.forEach((pos, i) =>
+                {
+                    if (this.isDiggable(pos)) return;
+                    this.stats.blocks++;
+                    if (MiningEngine.isOre(names[i])) this.stats.ores++;
+                });
+
+                const stuck = reachable.every(pos => this.isDiggable(pos));
+                remaining = remaining.filter(pos => this.isDiggable(pos));
+                if (stuck && moves++ > MAX_APPROACH_MOVES) return false;
+                continue;
+            }
+
+            if (moves++ > MAX_APPROACH_MOVES) return false;
+            if (!await this.moveToward(remaining[0])) return false;
+        }
+
+        return !skipped;
+    }
+
+    /**
+     * @brief Walks until a position is within a horizontal tolerance
+     * @param {Object} target - Target position
+     * @param {number} tolerance - Accepted horizontal distance in blocks
+     * @returns {boolean} True if the target was reached
+     */
+    async approach(target, tolerance)
+    {
+        for (let moves = 0; moves < MAX_APPROACH_MOVES; moves++)
+        {
+            const pos = this.actions.position();
+            if (Math.abs(pos.x - target.x) <= tolerance && Math.abs(pos.z - target.z) <= tolerance) return true;
+            if (!await this.moveToward(target)) return false;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Takes one step toward a target, digging through anything in the way
+     * @param {Object} target - Target position
+     * @returns {boolean} False if the way on is unsafe: a hazard, or a drop past MAX_DROP
+     */
+    async moveToward(target)
+    {
+        const pos = this.actions.position();
+        const dx = target.x - pos.x;
+        const dz = target.z - pos.z;
+
+        // Directly above an out-of-reach target: dig down
+        if (dx === 0 && dz === 0)
+        {
+            const below = { x: pos.x, y: pos.y - 1, z: pos.z };
+            if (target.y < pos.y && this.isDiggable(below)) return this.digPositions([below], true);
+            return true;
+        }
+
+        let direction;
+        if (Math.abs(dx) >= Math.abs(dz)) direction = dx > 0 ? 'east' : 'west';
+        else direction = dz > 0 ? 'south' : 'north';
+
+        const offset = DIRECTION_OFFSETS[direction];
+        const front = [
+            { x: pos.x + offset.x, y: pos.y + 1, z: pos.z + offset.z },
+            { x: pos.x + offset.x, y: pos.y, z: pos.z + offset.z }
+        ].filter(cell => this.isDiggable(cell));
+
+        if (!front.every(cell => this.isSafeToDig(cell))) return false;
+        if (front.length > 0)
+        {
+            await this.actions.dig_blocks(front, true, { signal: this.signal });
+            this.stats.blocks += front.filter(cell => !this.isDiggable(cell)).length;
+        }
+
+        const x = pos.x + offset.x;
+        const z = pos.z + offset.z;
+        const open = [pos.y, pos.y + 1].every(y => !this.isHazardAt(x, y, z));
+        if (!open || !this.hasFooting(x, pos.y, z)) return false;
+
+        await this.actions.step(direction, false, { signal: this.signal });
+        return true;
+    }
+
+    /**
+     * @brief Checks whether a position holds a block the engine may dig
+     * @param {Object} pos - Block position
+     * @returns {boolean} True if the block is solid and breakable
+     */
+    isDiggable(pos)
+    {
+        const block = this.bot.blockAt(new Vec3(pos.x, pos.y, pos.z));
+        return !!block && !UNBREAKABLE.has(block.name);
+    }
+
+    /**
+     * @brief Checks that digging a block neither lets a hazard in nor drops the bot too far
+     * @details A block touching lava (or another hazard) would open the way for it. The
+     *          block under the bot's feet is only dug if solid ground lies within
+     *          MAX_DROP blocks below it.
+     * @param {Object} pos - Block position
+     * @returns {boolean} True if the block may be dug
+     */
+    isSafeToDig(pos)
+    {
+        if (FACE_OFFSETS.some(offset => this.isHazardAt(pos.x + offset.x, pos.y + offset.y, pos.z + offset.z))) return false;
+
+        const feet = this.actions.position();
+        const underFeet = pos.x === feet.x && pos.z === feet.z && pos.y < feet.y;
+        return !underFeet || this.hasFooting(pos.x, pos.y, pos.z);
+    }
+
+    /**
+     * @brief Checks that a bot with its feet in a cell lands on solid, harmless ground
+     * @param {number} x - Cell X coordinate
+     * @param {number} y - Cell Y coordinate (feet level)
+     * @param {number} z - Cell Z coordinate
+     * @returns {boolean} True if a solid block lies within MAX_DROP blocks below the cell
+     *                    and nothing on the way down is a hazard
+     */
+    hasFooting(x, y, z)
+    {
+        for (let drop = 1; drop <= MAX_DROP + 1; drop++)
+        {
+            const block = this.actions.block_at(x, y - drop, z);
+            if (!block || this.actions.isHazard(block)) return false;
+            if (!this.actions.isPassable(block)) return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Checks whether a cell holds a hazard such as lava
+     * @param {number} x - X coordinate
+     * @param {number} y - Y coordinate
+     * @param {number} z - Z coordinate
+     * @returns {boolean} True for hazard blocks
+     */
+    isHazardAt(x, y, z)
+    {
+        const block = this.actions.block_at(x, y, z);
+        return !!block && this.actions.isHazard(block);
+    }
+
+    /**
+     * @brief Runs a time-boxed pickup round if drops are waiting
+     */
+    async collectDrops()
+    {
+        if (!this.collector || this.collector.pendingCount() === 0) return;
+
+        const result = await this.collector.collect({ signal: this.signal });
+        if (result.left > 0) console.log(`Left ${result.left} drops behind`);
+    }
+
+    //* REPORTING
+
+    /**
+     * @brief Records how far a run got, with the counters reached so far
+     * @param {Object} progress - Progress object of the run
+     * @param {number} done - Completed units of the mode (slices, main tunnel blocks, layers)
+     */
+    markProgress(progress, done)
+    {
+        progress.done = done;
+        progress.blocks = this.stats.blocks;
+        progress.ores = this.stats.ores;
+    }
+
+    /**
+     * @brief Restarts the counters for a new run
+     * @param {string|null} mode - Mode being run
+     */
+    resetReport(mode)
+    {
+        this.stats = { mode, blocks: 0, ores: 0, startTime: Date.now() };
+    }
+
+    /**
+     * @brief Builds the report of the current run
+     * @returns {Object} Mode, blocks, ores, seconds and ores per minute
+     */
+    report()
+    {
+        const seconds = (Date.now() - this.stats.startTime) / 1000;
+        return {
+            mode: this.stats.mode,
+            blocks: this.stats.blocks,
+            ores: this.stats.ores,
+            seconds: Math.round(seconds),
+            oresPerMinute: seconds > 0 ? (this.stats.ores * 60) / seconds : 0
+        };
+    }
+
+    //* HELPERS
+
+    /**
+     * @brief Position a number of blocks along a tunnel
+     * @param {Object} origin - Tunnel origin (feet level)
+     * @param {string} direction - Cardinal direction
+     * @param {number} distance - Blocks from the origin
+     * @returns {Object} Position at feet level
+     */
+    static alongTunnel(origin, direction, distance)
+    {
+        const offset = DIRECTION_OFFSETS[direction];
+        return { x: origin.x + offset.x * distance, y: origin.y, z: origin.z + offset.z * distance };
+    }
+
+    /**
+     * @brief Checks whether a block name is an ore
+     * @param {string} name - Block name
+     * @returns {boolean} True for ores and ancient debris
+     */
+    static isOre(name)
+    {
+        return name.endsWith('_ore') || name === 'ancient_debris';
+    }
+
+    /**
+     * @brief Maps deepslate variants onto their base ore
+     * @param {string} name - Block name
+     * @returns {string} Ore family name
+     */
+    static familyOf(name)
+    {
+        return name.replace(/^deepslate_/, '');
+    }
+
+    /**
+     * @brief Orders positions as a nearest neighbour walk from a start point
+     * @param {Object} start - Start position
+     * @param {Array} positions - Positions to order
+     * @returns {Array} Ordered positions
+     */
+    static nearestFirst(start, positions)
+    {
+        const remaining = positions.slice();
+        const ordered = [];
+        let from = start;
+
+        while (remaining.length > 0)
+        {
+            let best = 0, bestDistance = Infinity;
+            for (let i = 0; i < remaining.length; i++)
+            {
+                const p = remaining[i];
+                const distance = Math.abs(p.x - from.x) + Math.abs(p.y - from.y) + Math.abs(p.z - from.z);
+                if (distance < bestDistance) { bestDistance = distance; best = i; }
+            }
+            from = remaining.splice(best, 1)[0];
+            ordered.push(from);
+        }
+
+        return ordered;
+    }
+}
+
+module.exports = MiningEngine;
@@ -0,0 +1,215 @@
+/** *************************************************************************************
+
+    * @file        mission.js
+    * @brief       Mission description loader compiling states into an indexed transition table
+    * @author      Agustín I. Galdeman
+    * @author      Ian A. Dib
+    * @author      Luciano S. Cordero
+    * @date        2025-07-22
+    * @version     1.0 - Initial mission compiler module
+
+    ************************************************************************************* */
+
+
+/* **************************************************************************************
+    * INCLUDES AND DEPENDENCIES *
+   ************************************************************************************** */
+
+const crypto = require('crypto');
+const fs = require('fs');
+const path = require('path');
+
+
+/* **************************************************************************************
+    * CONSTANTS AND STATIC DATA *
+   ************************************************************************************** */
+
+// Mission loaded when none is given
+const DEFAULT_MISSION_PATH = path.join(__dirname, '..', 'missions', 'default.json');
+
+// Events a state handler can report, in table column order
+const EVENTS = { reached: 0, found: 1, done: 2, failed: 3, timeout: 4 };
+const EVENT_COUNT = Object.keys(EVENTS).length;
+
+// Transition targets that are not states
+const STAY = -1;
+const NEXT_GOAL = -2;
+const RESUME = -3;
+const SPECIAL_TARGETS = { $stay: STAY, $next_goal: NEXT_GOAL, $resume: RESUME };
+
+
+/* **************************************************************************************
+    * CLASS IMPLEMENTATIONS *
+   ************************************************************************************** */
+
+/**
+ * @class Mission
+ * @brief Compiled mission: goals plus a state table indexed by integer state and event codes
+ * @details A mission file names its states, the handler method that runs each one, the
+ *          state reached for every event, and optional retries and timeouts. Everything is
+ *          resolved once at load time: state names become indexes, handlers become bound
+ *          functions and transitions become one Int16Array row per state, so a tick costs
+ *          an array read and a call, never a string comparison.
+ *
+ *          State fields:
+ *            handler  - method of the owner returning an event code or undefined to stay
+ *            on       - { event: state | $next_goal | $resume | $stay }
+ *            retries  - 'failed' events absorbed before its transition is taken (default 0)
+ *            timeout  - milliseconds in the state before a 'timeout' event (default none)
+ *            chain    - run the handler in the same tick the state is entered
+ */
+class Mission
+{
+    /**
+     * @brief Constructor compiles a mission description against its owner
+     * @param {Object} description - Parsed mission file
+     * @param {Object} owner - Object providing the handler methods
+     * @throws {Error} If the description references unknown states, events or handlers
+     */
+    constructor(description, owner)
+    {
+        const states = Object.entries(description.states || {});
+        if (states.length === 0) throw new Error('Mission has no states');
+        if (!Array.isArray(description.goals) || description.goals.length === 0) throw new Error('Mission has no goals');
+
+        this.name = description.name || 'mission';
+
+        // Identifies this exact description, e.g. to reject checkpoints of an edited file
+        this.hash = crypto.createHash('sha1').update(JSON.stringify(description)).digest('hex');
+        this.goals = description.goals.map(goal => Object.assign({}, goal));
+
+        this.names = states.map(([name]) => name);
+        this.codes = new Map(this.names.map((name, index) => [name, index]));
+
+        this.handlers = new Array(states.length);
+        this.transitions = new Int16Array(states.length * EVENT_COUNT).fill(STAY);
+        this.retries = new Uint8Array(states.length);
+        this.timeouts = new Uint32Array(states.length);
+        this.chain = new Uint8Array(states.length);
+
+        states.forEach(([name, state], code) => this.compileState(name, state, code, owner));
+
+        this.final = this.code(description.final || 'COMPLETED');
+        this.entries = new Map(Object.entries(description.entries || {}).map(([type, name]) => [type, this.code(name)]));
+    }
+
+    /**
+     * @brief Reads and compiles a mission file
+     * @param {string} file - JSON mission path (default: missions/default.json)
+     * @param {Object} owner - Object providing the handler methods
+     * @returns {Mission} Compiled mission
+     * @throws {Error} If the file cannot be read or does not compile
+     */
+    static load(file, owner)
+    {
+        const missionPath = file || DEFAULT_MISSION_PATH;
+        const description = JSON.parse(fs.readFileSync(missionPath, 'utf8'));
+
+        try
+        {
+            return new Mission(description, owner);
+        }
+        catch (error)
+        {
+            throw new Error(`${path.basename(missionPath)}: ${error.message}`);
+        }
+    }
+
+    //* COMPILATION
+
+    /**
+     * @brief Resolves one state's handler, transitions and limits into the tables
+     * @param {string} name - State name
+     * @param {Object} state - State description
+     * @param {number} code - State index
+     * @param {Object} owner - Object providing the handler methods
+     * @throws {Error} If a reference does not resolve
+     */
+    compileState(name, state, code, owner)
+    {
+        const handler = owner[state.handler];
+        if (typeof handler !== 'function') throw new Error(`state ${name}: unknown handler ${state.handler}`);
+        this.handlers[code] = handler.bind(owner);
+
+        for (const [event, target] of Object.entries(state.on || {}))
+        {
+            if (!(event in EVENTS)) throw new Error(`state ${name}: unknown event ${event}`);
+            this.transitions[code * EVENT_COUNT + EVENTS[event]] = this.target(target);
+        }
+
+        this.retries[code] = state.retries || 0;
+        this.timeouts[code] = state.timeout || 0;
+        this.chain[code] = state.chain ? 1 : 0;
+
+        if (this.timeouts[code] > 0 && !state.on?.timeout) throw new Error(`state ${name}: timeout without a timeout transition`);
+    }
+
+    /**
+     * @brief Resolves a transition target to a state index or special code
+     * @param {string} target - State name or special target
+     * @returns {number} Target code
+     */
+    target(target)
+    {
+        return target in SPECIAL_TARGETS ? SPECIAL_TARGETS[target] : this.code(target);
+    }
+
+    //* LOOKUPS
+
+    /**
+     * @brief Index of a state, for entry points outside the table (commands, sub-modes)
+     * @param {string} name - State name
+     * @returns {number} State index
+     * @throws {Error} If the mission has no such state
+     */
+    code(name)
+    {
+        const code = this.codes.get(name);
+        if (code === undefined) throw new Error(`unknown state ${name}`);
+        return code;
+    }
+
+    /**
+     * @brief Next state for an event
+     * @param {number} code - Current state index
+     * @param {number} event - Event code
+     * @returns {number} State index, or STAY, NEXT_GOAL or RESUME
+     */
+    next(code, event)
+    {
+        return this.transitions[code * EVENT_COUNT + event];
+    }
+
+    /**
+     * @brief State that handles a goal type
+     * @param {string} type - Goal type
+     * @returns {number} State index
+     * @throws {Error} If the mission has no entry for the type
+     */
+    entry(type)
+    {
+        const code = this.entries.get(type);
+        if (code === undefined) throw new Error(`no entry state for goal type ${type}`);
+        return code;
+    }
+
+    /**
+     * @brief Event codes reported by state handlers
+     * @returns {Object} Event name to code
+     */
+    static get EVENTS()
+    {
+        return EVENTS;
+    }
+
+    /**
+     * @brief Special transition targets
+     * @returns {Object} { STAY, NEXT_GOAL, RESUME }
+     */
+    static get TARGETS()
+    {
+        return { STAY, NEXT_GOAL, RESUME };
+    }
+}
+
+module.exports = Mission;
@@ -0,0 +1,335 @@
+/** *************************************************************************************
+
+    * @file        movesim.js
+    * @brief       Forward physics simulation used to validate movements before executing them
+    * @author      Agustín I. Galdeman
+    * @author      Ian A. Dib
+    * @author      Luciano S. Cordero
+    * @date        2025-07-16
+    * @version     1.0 - Initial movement simulator module
+
+    ************************************************************************************* */
+
+
+/* **************************************************************************************
+    * INCLUDES AND DEPENDENCIES *
+   ************************************************************************************** */
+
+const { Physics, PlayerState } = require('prismarine-physics');
+const { Vec3 } = require('vec3');
+
+
+/* **************************************************************************************
+    * CONSTANTS AND STATIC DATA *
+   ************************************************************************************** */
+
+// Forward unit vectors and yaw of each cardinal direction (Mineflayer convention, north = 0)
+const DIRECTION_FRAMES =
+{
+    north: { x: 0, z: -1, yaw: 0 },
+    south: { x: 0, z: 1, yaw: Math.PI },
+    west: { x: -1, z: 0, yaw: Math.PI / 2 },
+    east: { x: 1, z: 0, yaw: -Math.PI / 2 }
+};
+
+// Candidate control sequences, cheapest first
+const CANDIDATES = [
+    { name: 'walk', controls: { forward: true }, ticks: 12 },
+    { name: 'jump', controls: { forward: true, jump: true }, ticks: 14 },
+    { name: 'sprint_jump', controls: { forward: true, sprint: true, jump: true }, ticks: 16 }
+];
+
+// Ticks simulated when looking for the landing point of a drop
+const FALL_TICKS = 30;
+
+// Ticks simulated when looking for the landing point of a sprint jump across a gap
+const GAP_JUMP_TICKS = 20;
+
+// Terrain window hashed for the cache: blocks ahead, to each side, below and above
+const SHAPE_AHEAD = 4;
+const SHAPE_SIDE = 1;
+const SHAPE_BELOW = 4;
+const SHAPE_ABOVE = 2;
+
+// Maximum cached terrain shapes before the cache is flushed
+const MAX_CACHE_SIZE = 4096;
+
+// Velocity quantization of the cache key, in blocks per tick
+const VELOCITY_STEP = 0.05;
+
+
+/* **************************************************************************************
+    * CLASS IMPLEMENTATIONS *
+   ************************************************************************************** */
+
+/**
+ * @class MoveSimulator
+ * @brief Rolls candidate control sequences a few ticks ahead with prismarine-physics
+ * @details This is the same physics engine Mineflayer runs every tick, applied to a copy
+ *          of the player state. Outcomes are cached per local terrain shape (solid/free
+ *          bits of a window oriented along the move direction), so repeated terrain
+ *          costs one map lookup instead of a rollout.
+ */
+class MoveSimulator
+{
+    /**
+     * @brief Constructor builds the physics engine for the bot's registry and world
+     * @param {Object} bot - Mineflayer bot instance
+     */
+    constructor(bot)
+    {
+        this.bot = bot;
+        this.physics = Physics(bot.registry, bot.world);
+        this.cache = new Map();
+        this.stats = { hits: 0, rollouts: 0 };
+    }
+
+    //* MOVE SELECTION
+
+    /**
+     * @brief Picks the cheapest control sequence that lands on a target cell
+     * @param {string} direction - Cardinal direction of the move
+     * @param {Object} target - Target feet cell with x, y, z
+     * @returns {string|null} Candidate name (walk, jump, sprint_jump) or null if none lands
+     */
+    chooseMove(direction, target)
+    {
+        const pos = this.bot.entity.position;
+        const rel = {
+            x: target.x - Math.floor(pos.x),
+            y: target.y - Math.floor(pos.y),
+            z: target.z - Math.floor(pos.z)
+        };
+        const key = `m:${direction}:${rel.x},${rel.y},${rel.z}:${this.shapeKey(direction)}`;
+
+        if (this.cache.has(key))
+        {
+            this.stats.hits++;
+            return this.cache.get(key);
+        }
+
+        let result = null;
+        for (const candidate of CANDIDATES)
+        {
+            if (this.landsOn(direction, candidate, target))
+            {
+                result = candidate.name;
+                break;
+            }
+        }
+
+        this.store(key, result);
+        return result;
+    }
+
+    /**
+     * @brief Predicts how far the bot drops when walking off the current cell
+     * @param {string} direction - Cardinal direction of the move
+     * @returns {number} Blocks fallen before landing (Infinity if no landing in range)
+     */
+    predictDrop(direction)
+    {
+        const key = `d:${direction}:${this.shapeKey(direction)}`;
+
+        if (this.cache.has(key))
+        {
+            this.stats.hits++;
+            return this.cache.get(key);
+        }
+
+        const startY = this.bot.entity.position.y;
+        const state = this.rollout(direction, CANDIDATES[0].controls, FALL_TICKS, (s, tick) =>
+            tick > 2 && s.onGround);
+
+        const drop = state.onGround ? Math.max(0, Math.round(startY - state.pos.y)) : Infinity;
+        this.store(key, drop);
+        return drop;
+    }
+
+    /**
+     * @brief Predicts where a sprint jump started now lands
+     * @details This is the move the executor runs for a gap, so it is the only one worth
+     *          validating; the landing cell is reported wherever it is, since a sprint
+     *          jump can overshoot a short gap.
+     * @param {string} direction - Cardinal direction of the jump
+     * @returns {Object|null} Landing cell relative to the bot's cell as { ahead, side, dy },
+     *          or null if the bot does not land within GAP_JUMP_TICKS
+     */
+    predictSprintJump(direction)
+    {
+        const key = `j:${direction}:${this.shapeKey(direction)}`;
+
+        if (this.cache.has(key))
+        {
+            this.stats.hits++;
+            return this.cache.get(key);
+        }
+
+        const frame = DIRECTION_FRAMES[direction];
+        const pos = this.bot.entity.position;
+        const sprintJump = CANDIDATES.find(candidate => candidate.name === 'sprint_jump');
+
+        let airborne = false;
+        const state = this.rollout(direction, sprintJump.controls, GAP_JUMP_TICKS, (s) =>
+        {
+            if (!s.onGround) airborne = true;
+            return airborne && s.onGround;
+        });
+
+        let landing = null;
+        if (airborne && state.onGround)
+        {
+            const dx = Math.floor(state.pos.x) - Math.floor(pos.x);
+            const dz = Math.floor(state.pos.z) - Math.floor(pos.z);
+            landing = {
+                ahead: dx * frame.x + dz * frame.z,
+                side: dz * frame.x - dx * frame.z,
+                dy: Math.floor(state.pos.y) - Math.floor(pos.y)
+            };
+        }
+
+        this.store(key, landing);
+        return landing;
+    }
+
+    //* SIMULATION
+
+    /**
+     * @brief Checks whether a candidate ends standing on the target cell
+     * @param {string} direction - Cardinal direction
+     * @param {Object} candidate - Candidate control sequence
+     * @param {Object} target - Target feet cell
+     * @returns {boolean} True if the rollout lands on the target
+     */
+    landsOn(direction, candidate, target)
+    {
+        const state = this.rollout(direction, candidate.controls, candidate.ticks, (s) =>
+            s.onGround &&
+            Math.floor(s.pos.x) === target.x &&
+            Math.floor(s.pos.y) === target.y &&
+            Math.floor(s.pos.z) === target.z);
+
+        return state.onGround &&
+            Math.floor(state.pos.x) === target.x &&
+            Math.floor(state.pos.y) === target.y &&
+            Math.floor(state.pos.z) === target.z;
+    }
+
+    /**
+     * @brief Simulates held controls from the current player state
+     * @param {string} direction - Cardinal direction faced during the rollout
+     * @param {Object} controls - Control states held for every tick
+     * @param {number} ticks - Maximum number of ticks
+     * @param {Function} done - Early exit predicate (state, tick) => boolean
+     * @returns {Object} Final simulated player state
+     */
+    rollout(direction, controls, ticks, done)
+    {
+        const control = Object.assign(
+            { forward: false, back: false, left: false, right: false, jump: false, sprint: false, sneak: false },
+            controls);
+
+        const state = new PlayerState(this.bot, control);
+        state.yaw = DIRECTION_FRAMES[direction].yaw;
+        this.stats.rollouts++;
+
+        for (let tick = 0; tick < ticks; tick++)
+        {
+            this.physics.simulatePlayer(state, this.bot.world);
+            if (done(state, tick)) break;
+        }
+
+        return state;
+    }
+
+    //* TERRAIN SHAPE CACHE
+
+    /**
+     * @brief Hashes the solid/free layout around the bot, oriented along a direction
+     * @param {string} direction - Cardinal direction
+     * @returns {string} Shape key including the bot's sub-block offset, velocity and
+     *          sprint state, which all change where a rollout lands
+     */
+    shapeKey(direction)
+    {
+        const frame = DIRECTION_FRAMES[direction];
+        const pos = this.bot.entity.position;
+        const fx = Math.floor(pos.x), fy = Math.floor(pos.y), fz = Math.floor(pos.z);
+
+        let bits = '';
+        for (let ahead = 0; ahead <= SHAPE_AHEAD; ahead++)
+        {
+            for (let side = -SHAPE_SIDE; side <= SHAPE_SIDE; side++)
+            {
+                // Side axis is the forward axis rotated by 90 degrees
+                const x = fx + frame.x * ahead - frame.z * side;
+                const z = fz + frame.z * ahead + frame.x * side;
+
+                for (let dy = -SHAPE_BELOW; dy <= SHAPE_ABOVE; dy++)
+                {
+                    const block = this.bot.blockAt(new Vec3(x, fy + dy, z));
+                    bits += block && block.boundingBox === 'block' ? '1' : '0';
+                }
+            }
+        }
+
+        // Quarter block offset along the move and ground contact change the outcome
+        const along = frame.x !== 0 ? (pos.x - fx) * frame.x : (pos.z - fz) * frame.z;
+        const offset = Math.floor(((along % 1) + 1) % 1 * 4);
+
+        // So does the momentum carried in: a rollout from standstill is not one at a run
+        const vel = this.bot.entity.velocity;
+        const forward = Math.round((vel.x * frame.x + vel.z * frame.z) / VELOCITY_STEP);
+        const vertical = Math.round(vel.y / VELOCITY_STEP);
+        const sprint = this.bot.getControlState('sprint') ? 1 : 0;
+
+        return `${bits}:${offset}:${this.bot.entity.onGround ? 1 : 0}:${forward},${vertical}:${sprint}`;
+    }
+
+    /**
+     * @brief Rebuilds the physics engine for the world of a new connection
+     * @details Cached outcomes only depend on terrain shapes and are kept.
+     */
+    reattach()
+    {
+        this.physics = Physics(this.bot.registry, this.bot.world);
+    }
+
+    /**
+     * @brief Lists the most recent cached outcomes for a checkpoint
+     * @details Outcomes depend only on the terrain shape, not on the position, so they stay
+     *          valid after a reconnect. Unlanded drops (Infinity) are written as null.
+     * @param {number} limit - Maximum entries, newest kept
+     * @returns {Array} [key, outcome] pairs
+     */
+    exportCache(limit = MAX_CACHE_SIZE)
+    {
+        const entries = [...this.cache].slice(-limit);
+        return entries.map(([key, value]) => [key, value === Infinity ? null : value]);
+    }
+
+    /**
+     * @brief Seeds the cache with outcomes from a checkpoint
+     * @param {Array} entries - [key, outcome] pairs from exportCache()
+     */
+    importCache(entries)
+    {
+        for (const [key, value] of entries)
+        {
+            this.store(key, value === null && key.startsWith('d:') ? Infinity : value);
+        }
+    }
+
+    /**
+     * @brief Stores a result, flushing the cache when it grows too large
+     * @param {string} key - Cache key
+     * @param {*} value - Result to cache
+     */
+    store(key, value)
+    {
+        if (this.cache.size >= MAX_CACHE_SIZE) this.cache.clear();
+        this.cache.set(key, value);
+    }
+}
+
+module.exports = MoveSimulator;
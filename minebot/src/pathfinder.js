@@ -26,6 +26,64 @@ const DIRECTION_OFFSETS = {
     east: { x: 1, z: 0 }
 };
 
+// Horizontal distance at which a goal counts as reached
+const GOAL_TOLERANCE = 1;
+
+// Steps to keep a detour direction before steering back toward the goal
+const DETOUR_STEPS = 4;
+
+// Pause before re-checking a cell occupied by a moving entity, in milliseconds
+const ENTITY_WAIT = 150;
+
+// Consecutive waits tolerated before stepping around a blocking entity
+const MAX_ENTITY_WAITS = 3;
+
+// Longest sprint jump (take-off to landing, in blocks) per landing height difference
+const PARKOUR_MAX_DISTANCE = { 0: 4, '-1': 5 };
+
+// Blocks climbed by holding jump while inside them
+const CLIMBABLE_BLOCKS = new Set([
+    'ladder', 'vine', 'scaffolding',
+    'twisting_vines', 'twisting_vines_plant', 'weeping_vines', 'weeping_vines_plant'
+]);
+
+// Movement axis of each direction; a door only clears the way along its facing axis
+const DIRECTION_AXES = { north: 'z', south: 'z', west: 'x', east: 'x' };
+
+// Name suffixes of blocks opened by hand; iron variants need redstone and stay walls
+const OPENABLE_SUFFIXES = ['_door', '_fence_gate', '_trapdoor'];
+const LOCKED_OPENABLES = new Set(['iron_door', 'iron_trapdoor']);
+
+// Farthest cell searched for the far floor when measuring a gap to bridge
+const MAX_BRIDGE_SCAN = 16;
+
+// Remaining air (out of 20) below which a submerged bot heads for the surface
+const LOW_OXYGEN = 8;
+
+// Highest drop in blocks accepted without fall damage
+const MAX_SAFE_DROP = 3;
+
+// Depth scanned below a gap for water that breaks the fall
+const MAX_WATER_DROP_SCAN = 24;
+
+// Estimated cost weights per block of horizontal, upward and downward travel
+const COST_WEIGHTS = { horizontal: 1, up: 2, down: 1 };
+
+// Cost of each movement kind, relative to one walked block; ranks detour directions
+// by their first move and is summed per goal as travelCost
+const MOVE_COSTS = {
+    move: 1,
+    jump_and_move: 2,
+    sprint_jump: 3,
+    swim: 2,
+    open_and_move: 2,
+    bridge: 3,
+    pillar: 3,
+    climb: 1.5,
+    change_direction: 0.5,
+    wait: 1
+};
+
 
 /* **************************************************************************************
     * CLASS IMPLEMENTATIONS *
@@ -40,11 +98,19 @@ class SimplePathfinder
     /**
      * @brief Constructor initializes pathfinder with actions reference
      * @param {Object} actions - BotActions instance for world queries
+     * @param {Object} entities - EntityGrid instance for dynamic obstacles (optional)
+     * @param {Object} simulator - MoveSimulator instance validating jumps and drops (optional)
      */
-    constructor(actions)
+    constructor(actions, entities = null, simulator = null)
     {
         this.actions = actions;
+        this.entities = entities;
+        this.simulator = simulator;
+        this.entityWaits = 0;
         this.currentDirection = 'east';
+        this.goal = null;
+        this.detourSteps = 0;
+        this.travelCost = 0;
         
         // Obstacle detection flags
         this.feetBlocked = false;
@@ -70,7 +136,7 @@ class SimplePathfinder
 
         // Check feet level (same Y as bot) in front
         const feetBlock = this.actions.block_at(frontPos.x, pos.y, frontPos.z);
-        if (feetBlock && feetBlock.name !== 'air')
+        if (feetBlock && !this.isPassable(feetBlock))
         {
             this.feetBlocked = true;
             console.log('feet');
@@ -78,7 +144,7 @@ class SimplePathfinder
 
         // Check head level (Y + 1) in front
         const headBlock = this.actions.block_at(frontPos.x, pos.y + 1, frontPos.z);
-        if (headBlock && headBlock.name !== 'air')
+        if (headBlock && !this.isPassable(headBlock))
         {
             this.headBlocked = true;
             console.log('head');
@@ -86,7 +152,7 @@ class SimplePathfinder
 
         // Check above head level (Y + 2) in front
         const aboveBlock = this.actions.block_at(frontPos.x, pos.y + 2, frontPos.z);
-        if (aboveBlock && aboveBlock.name !== 'air')
+        if (aboveBlock && !this.isPassable(aboveBlock))
         {
             this.aboveBlocked = true;
             console.log('above');
@@ -94,7 +160,7 @@ class SimplePathfinder
 
         // Check directly overhead of bot (Y + 2, same X/Z)
         const overheadBlock = this.actions.block_at(pos.x, pos.y + 2, pos.z);
-        if (overheadBlock && overheadBlock.name !== 'air')
+        if (overheadBlock && !this.isPassable(overheadBlock))
         {
             this.overheadBlocked = true;
             console.log('over');
@@ -102,32 +168,142 @@ class SimplePathfinder
     }
 
     /**
-     * @brief Determines next movement action based on current environment
+     * @brief Determines next movement action and adds its cost to the travel cost
      * @returns {Object} Movement decision with action type and parameters
      */
     getNextMovement()
+    {
+        const movement = this.decideMovement();
+        this.travelCost += this.movementCost(movement);
+        return movement;
+    }
+
+    /**
+     * @brief Determines next movement action based on current environment
+     * @returns {Object} Movement decision with action type and parameters
+     */
+    decideMovement()
     {
         this.scanEnvironment();
 
+        // Doors, gates and trapdoors ahead are opened on the way through
+        const door = this.getClosedOpenable();
+        if (door)
+        {
+            return {
+                action: 'open_and_move',
+                direction: this.currentDirection,
+                door: door
+            };
+        }
+
+        // Ladders and vines carry the bot up or down before any wall check
+        const climb = this.getClimbMovement();
+        if (climb) return climb;
+
+        // Pillar up cliffs toward a higher goal while building blocks last
+        if (this.headBlocked && this.canPillar())
+        {
+            return { action: 'pillar' };
+        }
+
         // Change direction if: head blocked OR (feet blocked AND (overhead OR above))
         if (this.headBlocked || (this.feetBlocked && (this.overheadBlocked || this.aboveBlocked)))
         {
             console.log('changing direction');
+            this.detourSteps = DETOUR_STEPS;
             return {
                 action: 'change_direction',
-                newDirection: this.getNextDirection()
+                newDirection: this.getCheapestDirection()
             };
         }
-        else if (this.feetBlocked && !this.headBlocked && !this.aboveBlocked)
+        else if (this.isInWater())
         {
-            // Jump if only feet blocked
+            // Swim toward the goal level, surfacing when air runs low
             return {
+                action: 'swim',
+                direction: this.currentDirection,
+                vertical: this.getSwimVertical()
+            };
+        }
+        else if (this.feetBlocked && !this.headBlocked && !this.aboveBlocked)
+        {
+            // Jump if only feet blocked, validated by simulation when available
+            return this.simulator ? this.getSimulatedStepUp() : {
                 action: 'jump_and_move',
                 direction: this.currentDirection
             };
         }
+        else if (this.entities && this.isEntityBlocked())
+        {
+            // Slow down for moving entities, step around ones that stay in the way
+            if (++this.entityWaits <= MAX_ENTITY_WAITS)
+            {
+                return {
+                    action: 'wait',
+                    duration: ENTITY_WAIT
+                };
+            }
+
+            this.entityWaits = 0;
+            this.detourSteps = DETOUR_STEPS;
+            return {
+                action: 'change_direction',
+                newDirection: this.getSideDirection()
+            };
+        }
         else
         {
+            this.entityWaits = 0;
+
+            // Steer back toward the goal once the detour is over
+            const preferred = this.getGoalDirection();
+            if (this.detourSteps > 0)
+            {
+                this.detourSteps--;
+            }
+            else if (preferred && preferred !== this.currentDirection)
+            {
+                return {
+                    action: 'change_direction',
+                    newDirection: preferred
+                };
+            }
+
+            // Jump across gaps instead of walking down into them
+            if (this.isFloorMissing())
+            {
+                const distance = this.findGapJump();
+                if (distance)
+                {
+                    return {
+                        action: 'sprint_jump',
+                        direction: this.currentDirection,
+                        distance: distance
+                    };
+                }
+
+                // Bridge over voids and over dips below the goal level
+                if (this.canBridge())
+                {
+                    return {
+                        action: 'bridge',
+                        direction: this.currentDirection
+                    };
+                }
+
+                // Turn away from drops that would hurt, unless they end in water
+                if (this.simulator && !this.isWaterLanding() &&
+                    this.simulator.predictDrop(this.currentDirection) > MAX_SAFE_DROP)
+                {
+                    this.detourSteps = DETOUR_STEPS;
+                    return {
+                        action: 'change_direction',
+                        newDirection: this.getCheapestDirection()
+                    };
+                }
+            }
+
             // Normal movement
             return {
                 action: 'move',
@@ -136,6 +312,458 @@ class SimplePathfinder
         }
     }
 
+    /**
+     * @brief Calculates the cardinal direction that best reduces the distance to the goal
+     * @returns {string|null} Direction along the dominant axis, or null without a goal
+     */
+    getGoalDirection()
+    {
+        if (!this.goal) return null;
+
+        const pos = this.actions.position();
+        const dx = this.goal.x - pos.x;
+        const dz = this.goal.z - pos.z;
+
+        if (dx === 0 && dz === 0) return null;
+        if (Math.abs(dx) >= Math.abs(dz)) return dx > 0 ? 'east' : 'west';
+        return dz > 0 ? 'south' : 'north';
+    }
+
+    /**
+     * @brief Chooses how to climb onto the block in front by simulating candidate moves
+     * @returns {Object} Movement decision: walk, jump, sprint jump or a direction change
+     */
+    getSimulatedStepUp()
+    {
+        const pos = this.actions.position();
+        const offset = DIRECTION_OFFSETS[this.currentDirection];
+        const target = { x: pos.x + offset.x, y: pos.y + 1, z: pos.z + offset.z };
+
+        switch (this.simulator.chooseMove(this.currentDirection, target))
+        {
+            case 'walk':
+                return { action: 'move', direction: this.currentDirection };
+
+            case 'jump':
+                return { action: 'jump_and_move', direction: this.currentDirection };
+
+            case 'sprint_jump':
+                return { action: 'jump_and_move', direction: this.currentDirection, sprint: true };
+
+            default:
+                this.detourSteps = DETOUR_STEPS;
+                return { action: 'change_direction', newDirection: this.getCheapestDirection() };
+        }
+    }
+
+    //* WATER AND CLIMBING
+
+    /**
+     * @brief Decides whether to climb up or down the ladder or vine the bot is in
+     * @details Climbing up is chosen when the goal is higher or a wall blocks the way
+     *          ahead; climbing down when the goal is lower and the climbable continues
+     *          below the feet.
+     * @returns {Object|null} Climb movement, or null to move horizontally
+     */
+    getClimbMovement()
+    {
+        const pos = this.actions.position();
+        const feet = this.actions.block_at(pos.x, pos.y, pos.z);
+        if (!feet || !CLIMBABLE_BLOCKS.has(feet.name)) return null;
+
+        const dy = this.goal ? this.goal.y - pos.y : 0;
+        const above = this.actions.block_at(pos.x, pos.y + 2, pos.z);
+        const below = this.actions.block_at(pos.x, pos.y - 1, pos.z);
+
+        if ((dy > 0 || (dy === 0 && this.headBlocked)) && (!above || this.isPassable(above) || CLIMBABLE_BLOCKS.has(above.name)))
+        {
+            return { action: 'climb', direction: this.currentDirection, up: true };
+        }
+
+        if (dy < 0 && below && CLIMBABLE_BLOCKS.has(below.name))
+        {
+            return { action: 'climb', direction: this.currentDirection, up: false };
+        }
+
+        return null;
+    }
+
+    /**
+     * @brief Checks whether the bot's feet or head are in water
+     * @returns {boolean} True while swimming
+     */
+    isInWater()
+    {
+        const pos = this.actions.position();
+        const feet = this.actions.block_at(pos.x, pos.y, pos.z);
+        const head = this.actions.block_at(pos.x, pos.y + 1, pos.z);
+        return (!!feet && feet.name === 'water') || (!!head && head.name === 'water');
+    }
+
+    /**
+     * @brief Picks the vertical swim direction from the goal height and remaining air
+     * @returns {string} 'up', 'down' or 'level'
+     */
+    getSwimVertical()
+    {
+        const pos = this.actions.position();
+        const head = this.actions.block_at(pos.x, pos.y + 1, pos.z);
+        const submerged = !!head && head.name === 'water';
+
+        // Surface first when air runs low, and leave the water over a blocked shore
+        if (submerged && this.actions.oxygenLevel() < LOW_OXYGEN) return 'up';
+        if (this.feetBlocked) return 'up';
+
+        if (!this.goal || this.goal.y === pos.y) return submerged ? 'up' : 'level';
+        return this.goal.y > pos.y ? 'up' : 'down';
+    }
+
+    /**
+     * @brief Checks whether falling off the front cell ends in water
+     * @returns {boolean} True if the first water or solid block below the front cell is water
+     */
+    isWaterLanding()
+    {
+        const pos = this.actions.position();
+        const offset = DIRECTION_OFFSETS[this.currentDirection];
+
+        for (let dy = 1; dy <= MAX_WATER_DROP_SCAN; dy++)
+        {
+            const block = this.actions.block_at(pos.x + offset.x, pos.y - dy, pos.z + offset.z);
+            if (!block) return false;
+            if (block.name === 'water' || !this.actions.isPassable(block)) return block.name === 'water';
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief Checks whether a block can be moved through at feet or head level
+     * @param {Object} block - Block from BotActions.block_at
+     * @returns {boolean} True for blocks without collision (air, water, grass, torches...),
+     *          climbables and open doors, gates and trapdoors
+     */
+    isPassable(block)
+    {
+        if (this.actions.isPassable(block) || CLIMBABLE_BLOCKS.has(block.name)) return true;
+        return SimplePathfinder.isOpenable(block) && this.isOpen(block);
+    }
+
+    //* DOORS AND GATES
+
+    /**
+     * @brief Finds a closed door, gate or trapdoor blocking the cell in front
+     * @details The front cell only counts as a door edge when opening the block clears
+     *          it: the other level must already be passable or part of the same door,
+     *          and a door must face along the path, or it would swing open into it.
+     * @returns {Object|null} Position of the block to open, or null if there is none
+     */
+    getClosedOpenable()
+    {
+        const pos = this.actions.position();
+        const offset = DIRECTION_OFFSETS[this.currentDirection];
+        const x = pos.x + offset.x, z = pos.z + offset.z;
+
+        const levels = [this.actions.block_at(x, pos.y, z), this.actions.block_at(x, pos.y + 1, z)];
+        if (levels.some(block => !block)) return null;
+
+        const closed = levels.find(block => this.isClosedAcross(block, this.currentDirection));
+        if (!closed) return null;
+
+        const clear = levels.every(block => this.isPassable(block) || SimplePathfinder.isOpenable(block));
+        return clear ? closed.position : null;
+    }
+
+    /**
+     * @brief Checks whether a block can be opened by hand
+     * @param {Object} block - Block from BotActions.block_at
+     * @returns {boolean} True for wooden doors, fence gates and trapdoors
+     */
+    static isOpenable(block)
+    {
+        return !LOCKED_OPENABLES.has(block.name) && OPENABLE_SUFFIXES.some(suffix => block.name.endsWith(suffix));
+    }
+
+    /**
+     * @brief Reads the open state of a door, gate or trapdoor
+     * @param {Object} block - Block from BotActions.block_at
+     * @returns {boolean} True if the block is open
+     */
+    isOpen(block)
+    {
+        const open = this.actions.blockState(block.position.x, block.position.y, block.position.z).open;
+        return open === true || open === 'true';
+    }
+
+    /**
+     * @brief Checks whether a block is a closed door, gate or trapdoor that opening clears
+     *        for travel in a direction
+     * @details A door panel blocks travel along its facing axis; a closed door facing
+     *          across the path lies along it and would swing into the path when opened.
+     * @param {Object} block - Block from BotActions.block_at
+     * @param {string} direction - Direction of travel
+     * @returns {boolean} True if the block should be opened to pass
+     */
+    isClosedAcross(block, direction)
+    {
+        if (!SimplePathfinder.isOpenable(block)) return false;
+
+        const state = this.actions.blockState(block.position.x, block.position.y, block.position.z);
+        if (state.open === true || state.open === 'true') return false;
+        return !block.name.endsWith('_door') || DIRECTION_AXES[state.facing] === DIRECTION_AXES[direction];
+    }
+
+    /**
+     * @brief Relative cost of a movement decision
+     * @param {Object} movement - Movement object returned by getNextMovement
+     * @returns {number} Cost in walked-block units
+     */
+    movementCost(movement)
+    {
+        const base = MOVE_COSTS[movement.action] || 1;
+        return movement.action === 'sprint_jump' ? base + movement.distance - 1 : base;
+    }
+
+    //* BRIDGING AND PILLARING
+
+    /**
+     * @brief Checks whether the gap ahead should and can be bridged
+     * @details Bridging is only worth it while heading for the goal at or above the
+     *          current level. The gap must be fully covered by the building blocks in
+     *          the inventory; without a far floor in sight the distance to the goal
+     *          along the current axis is used instead.
+     * @returns {boolean} True if a bridge block should be placed
+     */
+    canBridge()
+    {
+        if (!this.goal || this.goal.y < this.actions.position().y) return false;
+        if (this.getGoalDirection() !== this.currentDirection) return false;
+
+        const budget = this.actions.buildingBlocks();
+        return budget > 0 && budget >= this.getGapLength();
+    }
+
+    /**
+     * @brief Checks whether a pillar should and can be built to climb the wall ahead
+     * @returns {boolean} True if the goal is higher, the bot has room above its head
+     *          and enough building blocks to reach the goal level
+     */
+    canPillar()
+    {
+        if (!this.goal || this.overheadBlocked) return false;
+        if (this.getGoalDirection() !== this.currentDirection) return false;
+
+        const rise = this.goal.y - this.actions.position().y;
+        return rise > 0 && this.actions.buildingBlocks() >= rise;
+    }
+
+    /**
+     * @brief Counts the floorless cells ahead at the current level
+     * @returns {number} Gap length in blocks, or the distance to the goal along the
+     *          current axis if no floor is found within MAX_BRIDGE_SCAN
+     */
+    getGapLength()
+    {
+        const pos = this.actions.position();
+        const offset = DIRECTION_OFFSETS[this.currentDirection];
+
+        for (let distance = 1; distance <= MAX_BRIDGE_SCAN; distance++)
+        {
+            const floor = this.actions.block_at(pos.x + offset.x * distance, pos.y - 1, pos.z + offset.z * distance);
+            if (floor && floor.boundingBox === 'block') return distance - 1;
+        }
+
+        return Math.abs((this.goal.x - pos.x) * offset.x + (this.goal.z - pos.z) * offset.z);
+    }
+
+    //* GAP DETECTION
+
+    /**
+     * @brief Checks whether the cell in front has no floor to walk onto
+     * @returns {boolean} True if the block under the front cell is air
+     */
+    isFloorMissing()
+    {
+        const pos = this.actions.position();
+        const offset = DIRECTION_OFFSETS[this.currentDirection];
+        const floor = this.actions.block_at(pos.x + offset.x, pos.y - 1, pos.z + offset.z);
+        return !!floor && floor.name === 'air';
+    }
+
+    /**
+     * @brief Looks for a landing cell across a gap in the current direction
+     * @details Landing cells at the same level or one block lower are tried nearest
+     *          first. The arc (feet, head and the block above for every cell up to
+     *          the landing) must be free of collision boxes. With a simulator the sprint
+     *          jump itself is rolled out and accepted if it clears the gap onto a valid
+     *          landing, possibly past the nearest one; otherwise the PARKOUR_MAX_DISTANCE
+     *          table decides.
+     * @returns {number|null} Jump distance in blocks, or null if no gap jump is possible
+     */
+    findGapJump()
+    {
+        const pos = this.actions.position();
+        const offset = DIRECTION_OFFSETS[this.currentDirection];
+
+        // Headroom above the take-off cell
+        if (!this.isFreeAt(pos.x, pos.y + 2, pos.z)) return null;
+
+        for (let distance = 2; distance <= PARKOUR_MAX_DISTANCE[-1]; distance++)
+        {
+            const x = pos.x + offset.x * distance;
+            const z = pos.z + offset.z * distance;
+
+            // Every cell of the arc before the landing must be free
+            const arcX = pos.x + offset.x * (distance - 1), arcZ = pos.z + offset.z * (distance - 1);
+            if (!this.isFreeAt(arcX, pos.y, arcZ) || !this.isFreeAt(arcX, pos.y + 1, arcZ) || !this.isFreeAt(arcX, pos.y + 2, arcZ))
+            {
+                return null;
+            }
+
+            for (const dy of [0, -1])
+            {
+                if (distance > PARKOUR_MAX_DISTANCE[dy]) continue;
+                if (!this.isLandingAt(x, pos.y + dy, z)) continue;
+
+                if (!this.simulator) return distance;
+
+                // Validate the move that is executed, wherever it lands
+                const landing = this.simulator.predictSprintJump(this.currentDirection);
+                if (!landing || landing.side !== 0 || landing.ahead < distance || landing.dy < -1) return null;
+
+                const landX = pos.x + offset.x * landing.ahead, landZ = pos.z + offset.z * landing.ahead;
+                return this.isLandingAt(landX, pos.y + landing.dy, landZ) ? landing.ahead : null;
+            }
+        }
+
+        return null;
+    }
+
+    /**
+     * @brief Checks whether a cell can be landed on: solid floor, free feet and head
+     * @param {number} x - X coordinate of the feet cell
+     * @param {number} y - Y coordinate of the feet cell
+     * @param {number} z - Z coordinate of the feet cell
+     * @returns {boolean} True if the cell is a valid landing
+     */
+    isLandingAt(x, y, z)
+    {
+        const floor = this.actions.block_at(x, y - 1, z);
+        return !!floor && floor.boundingBox === 'block' && this.isFreeAt(x, y, z) && this.isFreeAt(x, y + 1, z);
+    }
+
+    /**
+     * @brief Checks whether a cell can be moved through
+     * @param {number} x - X coordinate
+     * @param {number} y - Y coordinate
+     * @param {number} z - Z coordinate
+     * @returns {boolean} True if the block is loaded and passable
+     */
+    isFreeAt(x, y, z)
+    {
+        const block = this.actions.block_at(x, y, z);
+        return !!block && this.actions.isPassable(block);
+    }
+
+    /**
+     * @brief Checks whether a mob or player occupies the cell in front
+     * @returns {boolean} True if the front cell is taken by an entity
+     */
+    isEntityBlocked()
+    {
+        const pos = this.actions.position();
+        const offset = DIRECTION_OFFSETS[this.currentDirection];
+        return this.entities.blockerAt(pos.x + offset.x, pos.y, pos.z + offset.z) !== null;
+    }
+
+    /**
+     * @brief Picks a perpendicular direction whose front cell is free of blocks and entities
+     * @returns {string} Side direction, or the next direction in sequence if both are taken
+     */
+    getSideDirection()
+    {
+        const pos = this.actions.position();
+        const sides = (this.currentDirection === 'north' || this.currentDirection === 'south') ?
+            ['east', 'west'] : ['north', 'south'];
+
+        for (const side of sides)
+        {
+            const offset = DIRECTION_OFFSETS[side];
+            const x = pos.x + offset.x, z = pos.z + offset.z;
+            const feet = this.actions.block_at(x, pos.y, z);
+            const head = this.actions.block_at(x, pos.y + 1, z);
+
+            if ((!feet || this.isPassable(feet)) && (!head || this.isPassable(head)) && !this.entities.blockerAt(x, pos.y, z))
+            {
+                return side;
+            }
+        }
+
+        return this.getNextDirection();
+    }
+
+    /**
+     * @brief Picks the detour direction whose first move and remaining distance cost least
+     * @details Each other direction is charged MOVE_COSTS for the move its front cell
+     *          calls for (walk, jump, swim, door, gap) plus the estimated cost from that
+     *          cell to the goal. Walls are skipped; ties go to the sides before turning back.
+     * @returns {string} Cheapest direction, or the next direction in sequence if all are walled
+     */
+    getCheapestDirection()
+    {
+        const pos = this.actions.position();
+        const current = DIRECTION_OFFSETS[this.currentDirection];
+        const isBack = (direction) => DIRECTION_OFFSETS[direction].x === -current.x && DIRECTION_OFFSETS[direction].z === -current.z;
+        const candidates = DIRECTIONS.filter(direction => direction !== this.currentDirection)
+            .sort((a, b) => isBack(a) - isBack(b));
+
+        let best = null, bestCost = Infinity;
+        for (const direction of candidates)
+        {
+            const offset = DIRECTION_OFFSETS[direction];
+            const front = { x: pos.x + offset.x, y: pos.y, z: pos.z + offset.z };
+
+            const action = this.firstMoveToward(front, direction);
+            if (!action) continue;
+
+            const cost = MOVE_COSTS[action] + (this.goal ? this.estimateCost(front, this.goal) : 0);
+            if (cost < bestCost)
+            {
+                best = direction;
+                bestCost = cost;
+            }
+        }
+
+        return best || this.getNextDirection();
+    }
+
+    /**
+     * @brief Classifies the move needed to enter a neighbouring cell
+     * @param {Object} front - Feet cell with x, y, z next to the bot
+     * @param {string} direction - Direction from the bot to the cell
+     * @returns {string|null} Movement kind, or null if a wall blocks the cell
+     */
+    firstMoveToward(front, direction)
+    {
+        const feet = this.actions.block_at(front.x, front.y, front.z);
+        const head = this.actions.block_at(front.x, front.y + 1, front.z);
+        if (!feet || !head) return null;
+
+        if (this.isClosedAcross(feet, direction) || this.isClosedAcross(head, direction)) return 'open_and_move';
+        if (!this.isPassable(head)) return null;
+
+        if (!this.isPassable(feet))
+        {
+            return this.isFreeAt(front.x, front.y + 2, front.z) ? 'jump_and_move' : null;
+        }
+
+        if (feet.name === 'water') return 'swim';
+
+        const floor = this.actions.block_at(front.x, front.y - 1, front.z);
+        if (floor && floor.name === 'air') return this.actions.buildingBlocks() > 0 ? 'bridge' : 'sprint_jump';
+        return 'move';
+    }
+
     /**
      * @brief Calculates next direction in sequence
      * @returns {string} Next direction to try
@@ -159,6 +787,48 @@ class SimplePathfinder
         }
     }
 
+    //* GOAL MANAGEMENT
+
+    /**
+     * @brief Sets the navigation goal
+     * @param {number} x - Goal X coordinate
+     * @param {number} y - Goal Y coordinate
+     * @param {number} z - Goal Z coordinate
+     */
+    setGoal(x, y, z)
+    {
+        this.goal = { x, y, z };
+        this.detourSteps = 0;
+        this.travelCost = 0;
+    }
+
+    /**
+     * @brief Checks whether the bot stands within tolerance of the goal
+     * @param {number} tolerance - Horizontal distance in blocks (default: 1)
+     * @returns {boolean} True if the goal is reached
+     */
+    hasReachedGoal(tolerance = GOAL_TOLERANCE)
+    {
+        if (!this.goal) return false;
+
+        const pos = this.actions.position();
+        return Math.abs(this.goal.x - pos.x) <= tolerance && Math.abs(this.goal.z - pos.z) <= tolerance;
+    }
+
+    /**
+     * @brief Estimates the travel cost between two positions
+     * @param {Object} from - Start position with x, y, z
+     * @param {Object} to - Target position with x, y, z
+     * @returns {number} Weighted Manhattan distance, climbing costs more than descending
+     */
+    estimateCost(from, to)
+    {
+        const horizontal = Math.abs(to.x - from.x) + Math.abs(to.z - from.z);
+        const dy = to.y - from.y;
+        const vertical = dy > 0 ? dy * COST_WEIGHTS.up : -dy * COST_WEIGHTS.down;
+        return horizontal * COST_WEIGHTS.horizontal + vertical;
+    }
+
     /**
      * @brief Gets current movement direction
      * @returns {string} Current direction
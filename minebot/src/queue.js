@@ -0,0 +1,342 @@
+/** *************************************************************************************
+
+    * @file        queue.js
+    * @brief       Priority action queue with resource locks, dependencies and backpressure
+    * @author      Agustín I. Galdeman
+    * @author      Ian A. Dib
+    * @author      Luciano S. Cordero
+    * @date        2025-07-18
+    * @version     1.0 - Initial action queue module
+
+    ************************************************************************************* */
+
+
+/* **************************************************************************************
+    * INCLUDES AND DEPENDENCIES *
+   ************************************************************************************** */
+
+const Abortable = require('./abort');
+
+
+/* **************************************************************************************
+    * CONSTANTS AND STATIC DATA *
+   ************************************************************************************** */
+
+// Default number of actions allowed to run at the same time
+const DEFAULT_MAX_IN_FLIGHT = 2;
+
+// Default number of actions allowed to wait before new ones are refused
+const DEFAULT_MAX_PENDING = 32;
+
+// Priority levels used by the bot, higher runs first
+const PRIORITIES = {
+    background: 0,
+    chat: 1,
+    movement: 2,
+    interaction: 3,
+    urgent: 4
+};
+
+
+/* **************************************************************************************
+    * CLASS IMPLEMENTATIONS *
+   ************************************************************************************** */
+
+/**
+ * @class ActionQueue
+ * @brief Schedules bot actions by priority while respecting locks, dependencies and caps
+ * @details An action names the resources it needs (e.g. 'look', 'movement', 'dig',
+ *          'window'); two actions sharing a resource never overlap, while actions on
+ *          different resources run side by side up to the in-flight cap, e.g. eating
+ *          while a queued rotation turns the head. An action may also name actions it
+ *          must run after, and is rejected if one of them fails.
+ *          When the pending list is full a new action only gets in by displacing a
+ *          lower priority one, which is rejected.
+ */
+class ActionQueue
+{
+    /**
+     * @brief Constructor initializes an empty queue
+     * @param {Object} options - { maxInFlight, maxPending } overriding the defaults
+     */
+    constructor(options = {})
+    {
+        this.maxInFlight = options.maxInFlight || DEFAULT_MAX_IN_FLIGHT;
+        this.maxPending = options.maxPending || DEFAULT_MAX_PENDING;
+
+        this.nextId = 1;
+        this.pending = [];          // entries waiting to start, in arrival order
+        this.running = new Map();   // id -> entry
+        this.locked = new Set();    // resources held by running entries
+        this.stats = { completed: 0, failed: 0, dropped: 0, maxInFlight: 0 };
+    }
+
+    //* SUBMISSION
+
+    /**
+     * @brief Queues an action and returns its id without waiting for it
+     * @param {Function} run - Action body (signal) => Promise
+     * @param {Object} options - { priority, resources, after, signal, label }
+     * @returns {Object} { id, promise } where promise settles with the action's result
+     */
+    submit(run, options = {})
+    {
+        const entry = {
+            id: this.nextId++,
+            run,
+            priority: options.priority ?? PRIORITIES.movement,
+            resources: options.resources || [],
+            after: (options.after || []).filter(id => this.isActive(id)),
+            signal: options.signal || null,
+            label: options.label || 'action'
+        };
+
+        entry.promise = new Promise((resolve, reject) =>
+        {
+            entry.resolve = resolve;
+            entry.reject = reject;
+        });
+
+        if (entry.signal && entry.signal.aborted)
+        {
+            entry.reject(Abortable.error(entry.signal));
+            return { id: entry.id, promise: entry.promise };
+        }
+
+        if (!this.admit(entry)) return { id: entry.id, promise: entry.promise };
+
+        if (entry.signal)
+        {
+            entry.onAbort = () => this.cancel(entry, Abortable.error(entry.signal));
+            entry.signal.addEventListener('abort', entry.onAbort, { once: true });
+        }
+
+        this.pump();
+        return { id: entry.id, promise: entry.promise };
+    }
+
+    /**
+     * @brief Queues an action and waits for its result
+     * @param {Function} run - Action body (signal) => Promise
+     * @param {Object} options - { priority, resources, after, signal, label }
+     * @returns {Promise} Result of the action
+     */
+    run(run, options = {})
+    {
+        return this.submit(run, options).promise;
+    }
+
+    /**
+     * @brief Adds an entry to the pending list, applying the backpressure policy
+     * @param {Object} entry - Queue entry
+     * @returns {boolean} True if the entry was accepted
+     */
+    admit(entry)
+    {
+        if (this.pending.length >= this.maxPending)
+        {
+            // Displace the lowest priority entry, newest first, if the new one ranks higher
+            let victim = -1;
+            for (let i = this.pending.length - 1; i >= 0; i--)
+            {
+                if (victim < 0 || this.pending[i].priority < this.pending[victim].priority) victim = i;
+            }
+
+            if (this.pending[victim].priority >= entry.priority)
+            {
+                this.stats.dropped++;
+                entry.reject(new Error(`Action queue full, dropped ${entry.label}`));
+                return false;
+            }
+
+            const [dropped] = this.pending.splice(victim, 1);
+            const error = new Error(`Action queue full, dropped ${dropped.label}`);
+            this.release(dropped);
+            this.stats.dropped++;
+            dropped.reject(error);
+            this.cancelDependants(dropped, error);
+        }
+
+        this.pending.push(entry);
+        return true;
+    }
+
+    //* SCHEDULING
+
+    /**
+     * @brief Starts every pending entry that is ready, highest priority first
+     */
+    pump()
+    {
+        while (this.running.size < this.maxInFlight)
+        {
+            const entry = this.nextReady();
+            if (!entry) return;
+
+            this.pending.splice(this.pending.indexOf(entry), 1);
+            this.start(entry);
+        }
+    }
+
+    /**
+     * @brief Picks the highest priority pending entry whose dependencies and locks are free
+     * @details Entries of equal priority keep their arrival order. A waiting entry also
+     *          reserves its resources against lower priority entries behind it, so a
+     *          stream of small actions cannot starve it.
+     * @returns {Object|null} Entry to start, or null if none is ready
+     */
+    nextReady()
+    {
+        const reserved = new Set();
+        const ordered = this.pending.slice().sort((a, b) => b.priority - a.priority || a.id - b.id);
+
+        for (const entry of ordered)
+        {
+            const blocked = entry.after.some(id => this.isActive(id)) ||
+                entry.resources.some(resource => this.locked.has(resource) || reserved.has(resource));
+
+            if (!blocked) return entry;
+            entry.resources.forEach(resource => reserved.add(resource));
+        }
+
+        return null;
+    }
+
+    /**
+     * @brief Runs an entry, holding its resources until it settles
+     * @param {Object} entry - Queue entry
+     */
+    start(entry)
+    {
+        entry.resources.forEach(resource => this.locked.add(resource));
+        this.running.set(entry.id, entry);
+        this.stats.maxInFlight = Math.max(this.stats.maxInFlight, this.running.size);
+
+        Promise.resolve()
+            .then(() => entry.run(entry.signal))
+            .then(
+                (value) => { this.stats.completed++; this.finish(entry, null); entry.resolve(value); },
+                (error) => { this.stats.failed++; this.finish(entry, error); entry.reject(error); });
+    }
+
+    /**
+     * @brief Releases a finished entry's locks and starts whatever it was blocking
+     * @param {Object} entry - Queue entry
+     * @param {Error|null} error - Failure of the entry, which also fails its dependants
+     */
+    finish(entry, error)
+    {
+        this.running.delete(entry.id);
+        entry.resources.forEach(resource => this.locked.delete(resource));
+        this.release(entry);
+
+        if (error) this.cancelDependants(entry, error);
+        this.pump();
+    }
+
+    //* CANCELLATION
+
+    /**
+     * @brief Removes a pending entry and rejects it; running entries stop through their signal
+     * @param {Object} entry - Queue entry
+     * @param {Error} error - Rejection reason
+     */
+    cancel(entry, error)
+    {
+        const index = this.pending.indexOf(entry);
+        if (index < 0) return;
+
+        this.pending.splice(index, 1);
+        this.release(entry);
+        entry.reject(error);
+        this.cancelDependants(entry, error);
+    }
+
+    /**
+     * @brief Rejects the pending entries that depend on an entry that will never succeed
+     * @param {Object} entry - Cancelled or failed entry
+     * @param {Error} error - Rejection reason
+     */
+    cancelDependants(entry, error)
+    {
+        for (const other of this.pending.slice())
+        {
+            if (other.after.includes(entry.id)) this.cancel(other, error);
+        }
+    }
+
+    /**
+     * @brief Rejects every pending entry, e.g. when the bot is preempted
+     * @param {string} reason - Rejection message
+     */
+    clear(reason = 'Action queue cleared')
+    {
+        const error = new Error(reason);
+        error.name = 'AbortError';
+
+        for (const entry of this.pending.splice(0))
+        {
+            this.release(entry);
+            entry.reject(error);
+        }
+    }
+
+    /**
+     * @brief Detaches an entry from its signal
+     * @param {Object} entry - Queue entry
+     */
+    release(entry)
+    {
+        if (entry.signal && entry.onAbort) entry.signal.removeEventListener('abort', entry.onAbort);
+    }
+
+    //* QUERIES
+
+    /**
+     * @brief Checks whether an action is still waiting or running
+     * @param {number} id - Action id returned by submit
+     * @returns {boolean} True until the action settles
+     */
+    isActive(id)
+    {
+        return this.running.has(id) || this.pending.some(entry => entry.id === id);
+    }
+
+    /**
+     * @brief Number of actions waiting to start
+     * @returns {number} Pending count
+     */
+    pendingCount()
+    {
+        return this.pending.length;
+    }
+
+    /**
+     * @brief Number of actions currently running
+     * @returns {number} In-flight count
+     */
+    inFlight()
+    {
+        return this.running.size;
+    }
+
+    /**
+     * @brief Checks whether new low priority work should be held back
+     * @returns {boolean} True if the pending list is full
+     */
+    isFull()
+    {
+        return this.pending.length >= this.maxPending;
+    }
+
+    /**
+     * @brief Priority levels used by the bot
+     * @returns {Object} Priority name to level
+     */
+    static get PRIORITIES()
+    {
+        return PRIORITIES;
+    }
+}
+
+module.exports = ActionQueue;
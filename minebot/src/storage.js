@@ -0,0 +1,199 @@
+/** *************************************************************************************
+
+    * @file        storage.js
+    * @brief       Container visiting order and bookkeeping for multi-chest storage runs
+    * @author      Agustín I. Galdeman
+    * @author      Ian A. Dib
+    * @author      Luciano S. Cordero
+    * @date        2025-07-05
+    * @version     1.0 - Initial storage run module
+
+    ************************************************************************************* */
+
+
+/* **************************************************************************************
+    * CONSTANTS AND STATIC DATA *
+   ************************************************************************************** */
+
+// Largest route improved with 2-opt; longer routes keep the nearest neighbour order
+const MAX_2OPT_CONTAINERS = 32;
+
+
+/* **************************************************************************************
+    * CLASS IMPLEMENTATIONS *
+   ************************************************************************************** */
+
+/**
+ * @class StorageRun
+ * @brief Ordered list of containers to visit and the contents read from each
+ */
+class StorageRun
+{
+    /**
+     * @brief Constructor orders the containers by estimated path cost
+     * @param {Object} start - Start position with x, y, z
+     * @param {Array} containers - Container positions with x, y, z
+     * @param {Function} costFn - Travel cost estimate (from, to) => number
+     * @param {Object} options - Optional { collect: boolean } to withdraw the contents
+     */
+    constructor(start, containers, costFn, options = {})
+    {
+        this.queue = StorageRun.order(start, containers, costFn);
+        this.index = 0;
+        this.collect = options.collect || false;
+        this.results = [];
+        this.startTime = Date.now();
+    }
+
+    //* PROGRESS
+
+    /**
+     * @brief Container currently being approached
+     * @returns {Object|null} Container position or null when the run is done
+     */
+    current()
+    {
+        return this.index < this.queue.length ? this.queue[this.index] : null;
+    }
+
+    /**
+     * @brief Moves on to the next container
+     */
+    advance()
+    {
+        this.index++;
+    }
+
+    /**
+     * @brief Checks whether every container has been visited
+     * @returns {boolean} True if the run is done
+     */
+    isDone()
+    {
+        return this.index >= this.queue.length;
+    }
+
+    /**
+     * @brief Stores what was read from a container
+     * @param {Object} container - Container position
+     * @param {Array|null} contents - Items read, or null if the container failed to open
+     */
+    record(container, contents)
+    {
+        this.results.push({ x: container.x, y: container.y, z: container.z, contents });
+    }
+
+    /**
+     * @brief Summarises the run
+     * @returns {Object} Visited count, failures, total items and average time per container
+     */
+    summary()
+    {
+        const elapsed = Date.now() - this.startTime;
+        let items = 0, failed = 0;
+
+        for (const result of this.results)
+        {
+            if (!result.contents) { failed++; continue; }
+            for (const item of result.contents) items += item.count;
+        }
+
+        return {
+            visited: this.results.length,
+            failed,
+            items,
+            msPerContainer: this.results.length ? Math.round(elapsed / this.results.length) : 0
+        };
+    }
+
+    //* ROUTE ORDERING
+
+    /**
+     * @brief Orders containers by a nearest neighbour tour refined with 2-opt
+     * @param {Object} start - Start position
+     * @param {Array} containers - Container positions
+     * @param {Function} costFn - Travel cost estimate (from, to) => number
+     * @returns {Array} Containers in visiting order
+     */
+    static order(start, containers, costFn)
+    {
+        const remaining = containers.slice();
+        const route = [];
+        let from = start;
+
+        while (remaining.length > 0)
+        {
+            let bestIndex = 0;
+            let bestCost = Infinity;
+
+            for (let i = 0; i < remaining.length; i++)
+            {
+                const cost = costFn(from, remaining[i]);
+                if (cost < bestCost) { bestCost = cost; bestIndex = i; }
+            }
+
+            from = remaining[bestIndex];
+            route.push(from);
+            remaining.splice(bestIndex, 1);
+        }
+
+        if (route.length > 2 && route.length <= MAX_2OPT_CONTAINERS) StorageRun.improve(start, route, costFn);
+        return route;
+    }
+
+    /**
+     * @brief Applies 2-opt segment reversals to an open route until none helps
+     * @details Whole route costs are compared because climbing and descending are
+     *          weighted differently, so a reversed segment changes its inner edges too.
+     * @param {Object} start - Fixed start position
+     * @param {Array} route - Route to improve in place
+     * @param {Function} costFn - Travel cost estimate (from, to) => number
+     */
+    static improve(start, route, costFn)
+    {
+        let bestCost = StorageRun.routeCost(start, route, costFn);
+        let improved = true;
+
+        while (improved)
+        {
+            improved = false;
+
+            for (let i = 0; i < route.length - 1; i++)
+            {
+                for (let j = i + 1; j < route.length; j++)
+                {
+                    const candidate = route.slice(0, i).concat(route.slice(i, j + 1).reverse(), route.slice(j + 1));
+                    const cost = StorageRun.routeCost(start, candidate, costFn);
+
+                    if (cost < bestCost)
+                    {
+                        route.splice(0, route.length, ...candidate);
+                        bestCost = cost;
+                        improved = true;
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Total estimated cost of an open route
+     * @param {Object} start - Start position
+     * @param {Array} route - Containers in visiting order
+     * @param {Function} costFn - Travel cost estimate (from, to) => number
+     * @returns {number} Sum of leg costs
+     */
+    static routeCost(start, route, costFn)
+    {
+        let total = 0;
+        let from = start;
+        for (const stop of route)
+        {
+            total += costFn(from, stop);
+            from = stop;
+        }
+        return total;
+    }
+}
+
+module.exports = StorageRun;
@@ -0,0 +1,478 @@
+/** *************************************************************************************
+
+    * @file        telemetry.js
+    * @brief       Local WebSocket server streaming binary telemetry and taking batched commands
+    * @author      Agustín I. Galdeman
+    * @author      Ian A. Dib
+    * @author      Luciano S. Cordero
+    * @date        2025-07-21
+    * @version     1.0 - Initial telemetry server module
+
+    ************************************************************************************* */
+
+
+/* **************************************************************************************
+    * INCLUDES AND DEPENDENCIES *
+   ************************************************************************************** */
+
+const { WebSocketServer } = require('ws');
+
+
+/* **************************************************************************************
+    * CONSTANTS AND STATIC DATA *
+   ************************************************************************************** */
+
+// Default listening address; only local processes may connect
+const DEFAULT_HOST = '127.0.0.1';
+const DEFAULT_PORT = 3008;
+
+// Interval between telemetry frames in milliseconds
+const TELEMETRY_INTERVAL = 500;
+
+// Frame type tags (first byte of every binary frame)
+const FRAME_TELEMETRY = 1;
+const FRAME_COMMANDS = 2;
+const FRAME_REPLIES = 3;
+const FRAME_STATES = 4;
+
+// State code sent for a bot without a mission or with more states than fit a byte
+const NO_STATE = 255;
+
+// Bytes per bot record before its inventory deltas, and per inventory delta
+const BOT_RECORD_SIZE = 31;
+const DELTA_SIZE = 4;
+
+
+/* **************************************************************************************
+    * CLASS IMPLEMENTATIONS *
+   ************************************************************************************** */
+
+/**
+ * @class TelemetryServer
+ * @brief Streams the state of every registered bot to local controllers over WebSocket
+ * @details All frames are binary and little endian. One telemetry frame covers the whole
+ *          fleet, so a controller needs a single socket whatever the fleet size.
+ *
+ *          Telemetry (server -> client):
+ *            u8 type=1, u32 ms since start, u16 bot count, then per bot:
+ *            u16 id, u8 state code, f32 x, f32 y, f32 z, u16 goal index, u16 ores, u16 blocks,
+ *            f32 travel cost, u8 actions running, u8 actions waiting, u8 health, u8 food,
+ *            u16 delta count, then per delta: u16 item id, i16 count change
+ *
+ *          Commands (client -> server), any number of bots per frame:
+ *            u8 type=2, u16 count, then per command: u16 bot id, u16 length, UTF-8 text
+ *            using the chat command syntax without prefix, e.g. "goto 10 64 -20"
+ *
+ *          Replies (server -> client): same layout as commands with type=3.
+ *
+ *          States (server -> client), naming the state codes of each bot's mission:
+ *            u8 type=4, u16 bot count, then per bot: u16 id, u8 state count, then per
+ *            state in code order: u8 length, UTF-8 name
+ *          Sent on connect and again before any telemetry frame once a bot's mission is
+ *          known or changes.
+ *
+ *          Inventory deltas are relative to the previous frame. A controller that connects
+ *          first receives a snapshot frame whose deltas are the counts the others already
+ *          hold, so the shared baseline never has to restart from zero.
+ */
+class TelemetryServer
+{
+    /**
+     * @brief Constructor initializes an idle server
+     * @param {Object} options - { host, port, interval } overriding the defaults
+     */
+    constructor(options = {})
+    {
+        this.host = options.host || DEFAULT_HOST;
+        this.port = options.port || DEFAULT_PORT;
+        this.interval = options.interval || TELEMETRY_INTERVAL;
+
+        this.server = null;
+        this.timer = null;
+        this.startTime = Date.now();
+        this.bots = new Map();      // id -> { source, inventory: Map(item id -> count), mission }
+        this.stats = { frames: 0, bytes: 0, commands: 0 };
+    }
+
+    //* LIFECYCLE
+
+    /**
+     * @brief Opens the listening socket and starts the telemetry timer
+     * @returns {Promise} Resolves once the server listens
+     */
+    start()
+    {
+        return new Promise((resolve, reject) =>
+        {
+            this.server = new WebSocketServer({
+                host: this.host,
+                port: this.port,
+                verifyClient: (info) => TelemetryServer.isLocalClient(info)
+            });
+            this.server.once('listening', () =>
+            {
+                // Later server errors are logged; an unhandled one would crash the bot
+                this.server.removeListener('error', reject);
+                this.server.on('error', (error) => console.log(`Telemetry server error: ${error.message}`));
+
+                console.log(`Telemetry listening on ws://${this.host}:${this.port}`);
+                resolve();
+            });
+            this.server.once('error', reject);
+            this.server.on('connection', (socket) => this.handleConnection(socket));
+
+            this.timer = setInterval(() => this.broadcast(), this.interval);
+            this.timer.unref();
+        });
+    }
+
+    /**
+     * @brief Stops the timer and closes every connection
+     */
+    stop()
+    {
+        if (this.timer) clearInterval(this.timer);
+        this.timer = null;
+
+        if (this.server) this.server.close();
+        this.server = null;
+    }
+
+    /**
+     * @brief Accepts only handshakes made outside a browser
+     * @details Binding to loopback keeps remote hosts out, but any web page open in a local
+     *          browser can still reach ws://127.0.0.1. Browsers always send an Origin header
+     *          and local controller processes do not, so a handshake carrying one is refused.
+     * @param {Object} info - ws handshake info { origin, secure, req }
+     * @returns {boolean} True if the connection may proceed
+     */
+    static isLocalClient(info)
+    {
+        if (!info.origin) return true;
+
+        console.log(`Telemetry refused connection from origin ${info.origin}`);
+        return false;
+    }
+
+    //* FLEET REGISTRY
+
+    /**
+     * @brief Adds a bot to the telemetry stream
+     * @details The source is read on every frame, so components rebuilt after a
+     *          reconnect are picked up without registering again.
+     * @param {number} id - Bot id used on the wire (0-65535)
+     * @param {Object} source - MinecraftBot instance (bot, actions, inventory, stateMachine, commands)
+     */
+    register(id, source)
+    {
+        this.bots.set(id, { source, inventory: new Map(), mission: null });
+    }
+
+    /**
+     * @brief Removes a bot from the telemetry stream
+     * @param {number} id - Bot id
+     */
+    unregister(id)
+    {
+        this.bots.delete(id);
+    }
+
+    //* TELEMETRY
+
+    /**
+     * @brief Sends one telemetry frame to every connected controller
+     */
+    broadcast()
+    {
+        if (!this.server || this.server.clients.size === 0) return;
+
+        // State names go out before the first record that uses their codes
+        if (this.missionsChanged()) this.broadcastStates();
+
+        const frame = this.encodeTelemetry();
+        for (const socket of this.server.clients)
+        {
+            if (socket.readyState === socket.OPEN) socket.send(frame, { binary: true });
+        }
+
+        this.stats.frames++;
+        this.stats.bytes += frame.length * this.server.clients.size;
+    }
+
+    /**
+     * @brief Encodes the telemetry frame of the whole fleet
+     * @param {boolean} snapshot - Send the last broadcast inventories as deltas from zero
+     *                             instead of advancing the baseline, for a new controller
+     * @returns {Buffer} Binary frame
+     */
+    encodeTelemetry(snapshot = false)
+    {
+        const records = [];
+        let size = 7;
+
+        for (const [id, entry] of this.bots)
+        {
+            const source = entry.source;
+            if (!source.isReady || !source.bot || !source.bot.entity) continue;
+
+            const deltas = snapshot ? Array.from(entry.inventory) : this.inventoryDeltas(entry);
+            records.push({ id, source, deltas });
+            size += BOT_RECORD_SIZE + deltas.length * DELTA_SIZE;
+        }
+
+        const frame = Buffer.alloc(size);
+        let offset = frame.writeUInt8(FRAME_TELEMETRY, 0);
+        offset = frame.writeUInt32LE((Date.now() - this.startTime) >>> 0, offset);
+        offset = frame.writeUInt16LE(records.length, offset);
+
+        for (const { id, source, deltas } of records)
+        {
+            offset = this.encodeBot(frame, offset, id, source, deltas);
+        }
+
+        return frame;
+    }
+
+    /**
+     * @brief Sends the state names of every bot's mission to every connected controller
+     */
+    broadcastStates()
+    {
+        const frame = this.encodeStates();
+        for (const socket of this.server.clients)
+        {
+            if (socket.readyState === socket.OPEN) socket.send(frame, { binary: true });
+        }
+    }
+
+    /**
+     * @brief Checks whether a bot's compiled mission differs from the one last published
+     * @returns {boolean} True if a states frame must be sent
+     */
+    missionsChanged()
+    {
+        for (const entry of this.bots.values())
+        {
+            const autonomous = entry.source.stateMachine;
+            if ((autonomous ? autonomous.mission : null) !== entry.mission) return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Encodes the state names of every bot's mission and marks them published
+     * @returns {Buffer} Binary frame
+     */
+    encodeStates()
+    {
+        const bots = [];
+        let size = 3;
+
+        for (const [id, entry] of this.bots)
+        {
+            const autonomous = entry.source.stateMachine;
+            entry.mission = autonomous ? autonomous.mission : null;
+
+            const names = entry.mission ? entry.mission.names.slice(0, NO_STATE).map(name => Buffer.from(name, 'utf8')) : [];
+            bots.push({ id, names });
+            size += 3 + names.reduce((total, name) => total + 1 + Math.min(name.length, 255), 0);
+        }
+
+        const frame = Buffer.alloc(size);
+        let offset = frame.writeUInt8(FRAME_STATES, 0);
+        offset = frame.writeUInt16LE(bots.length, offset);
+
+        for (const { id, names } of bots)
+        {
+            offset = frame.writeUInt16LE(id, offset);
+            offset = frame.writeUInt8(names.length, offset);
+            for (const name of names)
+            {
+                const length = Math.min(name.length, 255);
+                offset = frame.writeUInt8(length, offset);
+                offset += name.copy(frame, offset, 0, length);
+            }
+        }
+
+        return frame;
+    }
+
+    /**
+     * @brief Writes one bot record
+     * @param {Buffer} frame - Frame being written
+     * @param {number} offset - Write offset
+     * @param {number} id - Bot id
+     * @param {Object} source - Registered MinecraftBot
+     * @param {Array} deltas - Inventory changes [item id, change]
+     * @returns {number} Offset after the record
+     */
+    encodeBot(frame, offset, id, source, deltas)
+    {
+        const bot = source.bot;
+        const autonomous = source.stateMachine;
+        const pos = bot.entity.position;
+        const state = autonomous && autonomous.stateCode < NO_STATE ? autonomous.stateCode : NO_STATE;
+        const mining = (autonomous && autonomous.mining.stats) || { ores: 0, blocks: 0 };
+
+        offset = frame.writeUInt16LE(id, offset);
+        offset = frame.writeUInt8(state, offset);
+        offset = frame.writeFloatLE(pos.x, offset);
+        offset = frame.writeFloatLE(pos.y, offset);
+        offset = frame.writeFloatLE(pos.z, offset);
+        offset = frame.writeUInt16LE(autonomous ? Math.min(autonomous.currentGoalIndex, 0xffff) : 0, offset);
+        offset = frame.writeUInt16LE(Math.min(mining.ores, 0xffff), offset);
+        offset = frame.writeUInt16LE(Math.min(mining.blocks, 0xffff), offset);
+        offset = frame.writeFloatLE(autonomous ? autonomous.pathfinder.travelCost : 0, offset);
+        offset = frame.writeUInt8(autonomous ? Math.min(autonomous.queue.inFlight(), 255) : 0, offset);
+        offset = frame.writeUInt8(autonomous ? Math.min(autonomous.queue.pendingCount(), 255) : 0, offset);
+        offset = frame.writeUInt8(Math.max(0, Math.min(Math.round(bot.health || 0), 255)), offset);
+        offset = frame.writeUInt8(Math.max(0, Math.min(Math.round(bot.food || 0), 255)), offset);
+        offset = frame.writeUInt16LE(deltas.length, offset);
+
+        for (const [item, change] of deltas)
+        {
+            offset = frame.writeUInt16LE(item, offset);
+            offset = frame.writeInt16LE(Math.max(-32768, Math.min(change, 32767)), offset);
+        }
+
+        return offset;
+    }
+
+    /**
+     * @brief Diffs the inventory index against the counts sent in the previous frame
+     * @param {Object} entry - Registry entry holding the last sent counts
+     * @returns {Array} [item id, change] pairs for items whose count changed
+     */
+    inventoryDeltas(entry)
+    {
+        const index = entry.source.inventory;
+        const deltas = [];
+        if (!index) return deltas;
+
+        const current = new Map();
+        for (const [id, item] of index.byId) current.set(id, item.count);
+
+        for (const [id, count] of current)
+        {
+            const change = count - (entry.inventory.get(id) || 0);
+            if (change !== 0) deltas.push([id, change]);
+        }
+
+        for (const [id, count] of entry.inventory)
+        {
+            if (!current.has(id)) deltas.push([id, -count]);
+        }
+
+        entry.inventory = current;
+        return deltas;
+    }
+
+    //* COMMANDS
+
+    /**
+     * @brief Wires a new controller connection
+     * @param {Object} socket - WebSocket connection
+     */
+    handleConnection(socket)
+    {
+        // Malformed frames raise 'error' on the socket; drop that controller, not the bot
+        socket.on('error', (error) =>
+        {
+            console.log(`Telemetry connection error: ${error.message}`);
+            socket.terminate();
+        });
+
+        // Bring a late controller up to the state names and baseline the others already hold
+        if (this.missionsChanged()) this.broadcastStates();
+        else socket.send(this.encodeStates(), { binary: true });
+        socket.send(this.encodeTelemetry(true), { binary: true });
+
+        socket.on('message', (data, isBinary) =>
+        {
+            if (!isBinary) return;
+
+            try
+            {
+                const replies = this.runCommands(TelemetryServer.decodeCommands(data));
+                socket.send(TelemetryServer.encodeCommands(FRAME_REPLIES, replies), { binary: true });
+            }
+            catch (error)
+            {
+                console.log(`Telemetry command error: ${error.message}`);
+            }
+        });
+    }
+
+    /**
+     * @brief Dispatches a batch of commands to their bots' command tables
+     * @param {Array} commands - [bot id, command text] pairs
+     * @returns {Array} [bot id, reply text] pairs
+     */
+    runCommands(commands)
+    {
+        return commands.map(([id, text]) =>
+        {
+            this.stats.commands++;
+
+            const entry = this.bots.get(id);
+            if (!entry || !entry.source.commands) return [id, `Unknown or unready bot ${id}`];
+            return [id, entry.source.commands.dispatch(text)];
+        });
+    }
+
+    /**
+     * @brief Decodes a command frame
+     * @param {Buffer} data - Binary frame
+     * @returns {Array} [bot id, command text] pairs
+     * @throws {Error} If the frame is not a command frame or is truncated
+     */
+    static decodeCommands(data)
+    {
+        if (data.length < 3 || data.readUInt8(0) !== FRAME_COMMANDS) throw new Error('not a command frame');
+
+        const count = data.readUInt16LE(1);
+        const commands = [];
+        let offset = 3;
+
+        for (let i = 0; i < count; i++)
+        {
+            if (offset + 4 > data.length) throw new Error('truncated command frame');
+            const id = data.readUInt16LE(offset);
+            const length = data.readUInt16LE(offset + 2);
+            offset += 4;
+
+            if (offset + length > data.length) throw new Error('truncated command frame');
+            commands.push([id, data.toString('utf8', offset, offset + length)]);
+            offset += length;
+        }
+
+        return commands;
+    }
+
+    /**
+     * @brief Encodes [bot id, text] pairs as a command or reply frame
+     * @param {number} type - Frame type tag
+     * @param {Array} entries - [bot id, text] pairs
+     * @returns {Buffer} Binary frame
+     */
+    static encodeCommands(type, entries)
+    {
+        const texts = entries.map(([id, text]) => [id, Buffer.from(text, 'utf8')]);
+        const size = texts.reduce((total, [, bytes]) => total + 4 + bytes.length, 3);
+
+        const frame = Buffer.alloc(size);
+        let offset = frame.writeUInt8(type, 0);
+        offset = frame.writeUInt16LE(texts.length, offset);
+
+        for (const [id, bytes] of texts)
+        {
+            offset = frame.writeUInt16LE(id, offset);
+            offset = frame.writeUInt16LE(bytes.length, offset);
+            offset += bytes.copy(frame, offset);
+        }
+
+        return frame;
+    }
+}
+
+module.exports = TelemetryServer;
@@ -0,0 +1,397 @@
+/** *************************************************************************************
+
+    * @file        tools.js
+    * @brief       Best tool selection and dig time aware scheduling of block breaking
+    * @author      Agustín I. Galdeman
+    * @author      Ian A. Dib
+    * @author      Luciano S. Cordero
+    * @date        2025-07-07
+    * @version     1.0 - Initial tool selection module
+
+    ************************************************************************************* */
+
+
+/* **************************************************************************************
+    * CONSTANTS AND STATIC DATA *
+   ************************************************************************************** */
+
+// Inventory tags considered as digging tools
+const TOOL_TAGS = ['pickaxe', 'axe', 'shovel', 'hoe', 'sword', 'shears'];
+
+// Estimated cost of switching the held item in milliseconds (one tick plus the packet)
+const SWAP_COST = 50;
+
+// Key used for the empty hand in tool maps
+const HAND = 'hand';
+
+// Window slots of the hotbar
+const HOTBAR_START = 36;
+const HOTBAR_END = 45;
+
+
+/* **************************************************************************************
+    * CLASS IMPLEMENTATIONS *
+   ************************************************************************************** */
+
+/**
+ * @class ToolSelector
+ * @brief Computes expected break times per tool and plans tool usage for dig sequences
+ * @details Break times come from prismarine-block's digTime, which combines the
+ *          minecraft-data hardness, material tool multipliers, harvest requirements,
+ *          efficiency enchantments and haste/fatigue effects. Results are memoised per
+ *          block type and tool until the bot's effects change.
+ */
+class ToolSelector
+{
+    /**
+     * @brief Constructor initializes the selector
+     * @param {Object} bot - Mineflayer bot instance
+     * @param {Object} inventory - InventoryIndex instance used to enumerate tools
+     */
+    constructor(bot, inventory)
+    {
+        this.bot = bot;
+        this.inventory = inventory;
+        this.cache = new Map();
+
+        this.stats = { blocks: 0, swaps: 0, startTime: Date.now() };
+
+        this.onEffect = (entity) =>
+        {
+            if (entity === this.bot.entity) this.cache.clear();
+        };
+        this.bot.on('entityEffect', this.onEffect);
+        this.bot.on('entityEffectEnd', this.onEffect);
+    }
+
+    //* BREAK TIME ESTIMATION
+
+    /**
+     * @brief Lists every tool stack in the inventory, plus whatever is in the hand
+     * @details All stacks are listed, not one per tag, so break times rather than wear
+     *          decide between e.g. a worn diamond and a fresh stone pickaxe; the stacks
+     *          are ordered by remaining durability, which therefore breaks ties. A held
+     *          item breaks anything at least as fast as the empty hand, so the hand is
+     *          only a candidate when nothing is held. Reaching an empty hand would take
+     *          an unequip, which tosses the item when the inventory is full.
+     * @returns {Array} Item stacks, held first, with null standing for the empty hand
+     */
+    candidates()
+    {
+        const held = this.bot.heldItem || null;
+        const tools = [];
+        const seen = new Set([ToolSelector.keyOf(held)]);
+
+        if (this.inventory)
+        {
+            for (const tag of TOOL_TAGS)
+            {
+                for (const slot of this.inventory.slotsOfTag(tag))
+                {
+                    const item = this.inventory.itemAt(slot);
+                    if (!item || seen.has(slot)) continue;
+
+                    seen.add(slot);
+                    tools.push(item);
+                }
+            }
+        }
+
+        tools.sort((a, b) => (ToolSelector.remaining(b) - ToolSelector.remaining(a)) || 0);
+        return [held, ...tools];
+    }
+
+    /**
+     * @brief Expected time to break a block with a given tool
+     * @param {Object} block - Block to break
+     * @param {Object|null} item - Tool stack, or null for the empty hand
+     * @returns {number} Break time in milliseconds (Infinity if unbreakable)
+     */
+    breakTime(block, item)
+    {
+        const entity = this.bot.entity;
+        const enchants = item && item.enchants ? item.enchants : [];
+        const efficiency = enchants.find(e => e.name === 'efficiency');
+        const key = `${block.type}:${item ? item.type : HAND}:${efficiency ? efficiency.lvl : 0}:${entity.isInWater ? 1 : 0}:${entity.onGround ? 1 : 0}`;
+
+        let time = this.cache.get(key);
+        if (time === undefined)
+        {
+            time = block.digTime(item ? item.type : null, false, entity.isInWater, !entity.onGround, enchants, entity.effects);
+            this.cache.set(key, time);
+        }
+
+        return time;
+    }
+
+    /**
+     * @brief Picks the fastest tool that still harvests the block
+     * @param {Object} block - Block to break
+     * @returns {Object} Object with item (null for hand) and time in milliseconds
+     */
+    bestFor(block)
+    {
+        let best = null;
+
+        for (const item of this.candidates())
+        {
+            const time = this.breakTime(block, item);
+            const harvests = block.canHarvest(item ? item.type : null);
+
+            // A harvesting tool always beats one that destroys the drop; the held item
+            // comes first, so it wins ties and saves the swap, then the least worn tool
+            if (!best || (harvests && !best.harvests) || (harvests === best.harvests && time < best.time))
+            {
+                best = { item, time, harvests };
+            }
+        }
+
+        return { item: best.item, time: best.time };
+    }
+
+    //* TOOL MANAGEMENT
+
+    /**
+     * @brief Key of the stack currently held, or the hand key
+     * @returns {number|string} Held slot or HAND
+     */
+    heldKey()
+    {
+        return ToolSelector.keyOf(this.bot.heldItem);
+    }
+
+    /**
+     * @brief Equips a tool unless it is already held
+     * @details The empty hand is reached by selecting an empty hotbar slot, never by
+     *          unequipping, which would toss the held item on a full inventory. Without
+     *          an empty hotbar slot the held item is kept.
+     * @param {Object|null} item - Tool stack, or null for the empty hand
+     * @returns {Promise<boolean>} True if a swap was performed
+     */
+    async equip(item)
+    {
+        if (ToolSelector.keyOf(item) === this.heldKey()) return false;
+
+        if (item)
+        {
+            await this.bot.equip(item, 'hand');
+        }
+        else
+        {
+            const slot = this.emptyHotbarSlot();
+            if (slot < 0) return false;
+            this.bot.setQuickBarSlot(slot - HOTBAR_START);
+        }
+
+        this.stats.swaps++;
+        return true;
+    }
+
+    /**
+     * @brief Finds an empty hotbar slot
+     * @returns {number} Window slot index, or -1 if the hotbar is full
+     */
+    emptyHotbarSlot()
+    {
+        const slots = this.bot.inventory.slots;
+        for (let slot = HOTBAR_START; slot < HOTBAR_END; slot++)
+        {
+            if (!slots[slot]) return slot;
+        }
+        return -1;
+    }
+
+    /**
+     * @brief Equips the fastest tool for a block
+     * @param {Object} block - Block about to be dug
+     * @returns {Promise<number>} Expected break time in milliseconds
+     */
+    async equipFor(block)
+    {
+        const best = this.bestFor(block);
+        await this.equip(best.item);
+        return best.time;
+    }
+
+    //* DIG SCHEDULING
+
+    /**
+     * @brief Plans the dig order and tool per block minimising total time with swaps
+     * @details Unordered sets are grouped by best tool, starting with the held one, so
+     *          each tool is equipped once. Ordered sequences keep their order and pick
+     *          tools by dynamic programming over the held tool, which may keep a slower
+     *          tool for a block when swapping would cost more than it saves.
+     * @param {Array} blocks - Blocks to dig
+     * @param {boolean} ordered - Keep the given order (default: false)
+     * @returns {Object} Plan with steps [{ block, item, time }] and total time in ms
+     */
+    schedule(blocks, ordered = false)
+    {
+        if (blocks.length === 0) return { steps: [], total: 0 };
+        return ordered ? this.scheduleOrdered(blocks) : this.scheduleGrouped(blocks);
+    }
+
+    /**
+     * @brief Groups blocks by their fastest tool, held tool first
+     * @param {Array} blocks - Blocks to dig
+     * @returns {Object} Plan with steps and total time
+     */
+    scheduleGrouped(blocks)
+    {
+        const groups = new Map();
+        for (const block of blocks)
+        {
+            const best = this.bestFor(block);
+            const key = ToolSelector.keyOf(best.item);
+            if (!groups.has(key)) groups.set(key, []);
+            groups.get(key).push({ block, item: best.item, time: best.time });
+        }
+
+        const held = this.heldKey();
+        const keys = [...groups.keys()].sort((a, b) => (b === held) - (a === held));
+
+        const steps = [];
+        let total = 0;
+        for (const key of keys)
+        {
+            if (key !== held || steps.length > 0) total += SWAP_COST;
+            for (const step of groups.get(key))
+            {
+                steps.push(step);
+                total += step.time;
+            }
+        }
+
+        return { steps, total };
+    }
+
+    /**
+     * @brief Chooses a tool per block for a fixed order by dynamic programming
+     * @param {Array} blocks - Blocks to dig, in order
+     * @returns {Object} Plan with steps and total time
+     */
+    scheduleOrdered(blocks)
+    {
+        // Candidates start with the held item
+        const tools = this.candidates();
+
+        // cost[t] = best total ending with tool t; choice[i][t] = previous tool
+        let cost = tools.map((_, t) => (t === 0 ? 0 : SWAP_COST));
+        const choice = [];
+
+        for (let i = 0; i < blocks.length; i++)
+        {
+            const next = [];
+            const from = [];
+            for (let t = 0; t < tools.length; t++)
+            {
+                const harvests = blocks[i].canHarvest(tools[t] ? tools[t].type : null);
+                const time = harvests ? this.breakTime(blocks[i], tools[t]) : Infinity;
+
+                let best = Infinity, bestPrev = t;
+                for (let p = 0; p < tools.length; p++)
+                {
+                    const value = cost[p] + (p === t ? 0 : SWAP_COST);
+                    if (value < best) { best = value; bestPrev = p; }
+                }
+
+                next.push(best + time);
+                from.push(bestPrev);
+            }
+            choice.push(from);
+            cost = next;
+        }
+
+        let tool = cost.indexOf(Math.min(...cost));
+        const total = cost[tool];
+
+        // Nothing harvests some block: fall back to the fastest tool per block, keeping the order
+        if (total === Infinity) return this.scheduleFastest(blocks);
+
+        const steps = new Array(blocks.length);
+        for (let i = blocks.length - 1; i >= 0; i--)
+        {
+            steps[i] = { block: blocks[i], item: tools[tool], time: this.breakTime(blocks[i], tools[tool]) };
+            tool = choice[i][tool];
+        }
+
+        return { steps, total };
+    }
+
+    /**
+     * @brief Picks each block's fastest tool without reordering the blocks
+     * @param {Array} blocks - Blocks to dig, in order
+     * @returns {Object} Plan with steps and total time
+     */
+    scheduleFastest(blocks)
+    {
+        const steps = [];
+        let total = 0;
+        let held = this.heldKey();
+
+        for (const block of blocks)
+        {
+            const best = this.bestFor(block);
+            const key = ToolSelector.keyOf(best.item);
+            if (key !== held) total += SWAP_COST;
+            held = key;
+
+            steps.push({ block, item: best.item, time: best.time });
+            total += best.time;
+        }
+
+        return { steps, total };
+    }
+
+    //* HELPERS
+
+    /**
+     * @brief Identifies a tool stack by its slot, so equal tools with different wear differ
+     * @param {Object|null} item - Item stack, or null for the empty hand
+     * @returns {number|string} Slot index, or HAND
+     */
+    static keyOf(item)
+    {
+        return item ? item.slot : HAND;
+    }
+
+    /**
+     * @brief Remaining durability of a stack
+     * @param {Object} item - Item stack
+     * @returns {number} Uses left, Infinity for items that do not wear
+     */
+    static remaining(item)
+    {
+        return item.maxDurability ? item.maxDurability - (item.durabilityUsed || 0) : Infinity;
+    }
+
+    //* STATISTICS
+
+    /**
+     * @brief Records a finished dig for throughput reporting
+     */
+    recordDig()
+    {
+        this.stats.blocks++;
+    }
+
+    /**
+     * @brief Mining throughput since the selector was created or reset
+     * @returns {number} Blocks per minute
+     */
+    blocksPerMinute()
+    {
+        const minutes = (Date.now() - this.stats.startTime) / 60000;
+        return minutes > 0 ? this.stats.blocks / minutes : 0;
+    }
+
+    /**
+     * @brief Restarts the throughput counters
+     */
+    resetStats()
+    {
+        this.stats = { blocks: 0, swaps: 0, startTime: Date.now() };
+    }
+}
+
+module.exports = ToolSelector;
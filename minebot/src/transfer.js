@@ -0,0 +1,381 @@
+/** *************************************************************************************
+
+    * @file        transfer.js
+    * @brief       Click sequence planner for moving items between containers and inventory
+    * @author      Agustín I. Galdeman
+    * @author      Ian A. Dib
+    * @author      Luciano S. Cordero
+    * @date        2025-07-04
+    * @version     1.0 - Initial transfer planner module
+
+    ************************************************************************************* */
+
+
+/* **************************************************************************************
+    * INCLUDES AND DEPENDENCIES *
+   ************************************************************************************** */
+
+const Abortable = require('./abort');
+
+
+/* **************************************************************************************
+    * CONSTANTS AND STATIC DATA *
+   ************************************************************************************** */
+
+// Window click modes as defined by the protocol
+const CLICK_MODE =
+{
+    pickup: 0,
+    shift: 1,
+    swap: 2
+};
+
+// Mouse buttons used with the pickup mode
+const MOUSE_BUTTON =
+{
+    left: 0,
+    right: 1
+};
+
+// Maximum number of clicks sent before waiting for the oldest one to settle
+const DEFAULT_PIPELINE_DEPTH = 8;
+
+// Stack size assumed when an item does not report one
+const DEFAULT_STACK_SIZE = 64;
+
+
+/* **************************************************************************************
+    * CLASS IMPLEMENTATIONS *
+   ************************************************************************************** */
+
+/**
+ * @class TransferPlanner
+ * @brief Plans minimal window click sequences for an inventory delta and pipelines them
+ * @details Full stacks move with one shift-click (or one hotbar swap when a hotbar slot
+ *          is requested), partial amounts use the cheapest of half pickup, right-click
+ *          distribution or right-click return, and partial stacks are merged into
+ *          existing stacks before empty slots are used. Planning runs on a copy of the
+ *          window slots so later steps see the result of earlier clicks.
+ */
+class TransferPlanner
+{
+    /**
+     * @brief Constructor initializes the planner
+     * @param {Object} bot - Mineflayer bot instance
+     */
+    constructor(bot)
+    {
+        this.bot = bot;
+    }
+
+    //* PLANNING
+
+    /**
+     * @brief Computes the click sequence for a desired inventory delta
+     * @param {Object} window - Open container window
+     * @param {Object} delta - Item name to amount; positive withdraws, negative deposits
+     * @param {Object} options - Optional { hotbar: { itemName: hotbarIndex } }
+     * @returns {Object} Plan with clicks array and per item shortfall
+     */
+    plan(window, delta, options = {})
+    {
+        const slots = window.slots.map(item => item ?
+            { name: item.name, count: item.count, stackSize: item.stackSize || DEFAULT_STACK_SIZE } : null);
+
+        const container = { start: 0, end: window.inventoryStart, reverse: false };
+        const player = { start: window.inventoryStart, end: window.inventoryEnd, reverse: true };
+        const hotbar = options.hotbar || {};
+
+        const clicks = [];
+        const shortfall = {};
+
+        for (const name in delta)
+        {
+            const amount = delta[name];
+            if (amount === 0) continue;
+
+            const missing = amount > 0 ?
+                this.planMove(slots, name, amount, container, player, clicks, TransferPlanner.hotbarIndex(hotbar[name])) :
+                this.planMove(slots, name, -amount, player, container, clicks, null);
+
+            if (missing > 0) shortfall[name] = missing;
+        }
+
+        return { clicks, shortfall };
+    }
+
+    /**
+     * @brief Plans the clicks moving an amount of one item between two slot ranges
+     * @param {Array} slots - Simulated window slots, updated in place
+     * @param {string} name - Item name
+     * @param {number} amount - Number of items to move
+     * @param {Object} from - Source range { start, end, reverse }
+     * @param {Object} to - Destination range { start, end, reverse }
+     * @param {Array} clicks - Click list to append to
+     * @param {number|null} hotbarIndex - Requested hotbar destination 0-8, if any
+     * @returns {number} Amount that could not be moved
+     */
+    planMove(slots, name, amount, from, to, clicks, hotbarIndex)
+    {
+        let remaining = amount;
+        let hotbarSlot = hotbarIndex === null ? null : to.end - 9 + hotbarIndex;
+
+        const sources = [];
+        for (let slot = from.start; slot < from.end; slot++)
+        {
+            if (slots[slot] && slots[slot].name === name) sources.push(slot);
+        }
+        sources.sort((a, b) => slots[b].count - slots[a].count);
+
+        // Whole stacks: a single click each
+        for (const source of sources)
+        {
+            const stack = slots[source];
+            if (remaining <= 0) break;
+            if (stack.count > remaining) continue;
+
+            if (hotbarSlot !== null && !slots[hotbarSlot])
+            {
+                clicks.push({ slot: source, button: hotbarIndex, mode: CLICK_MODE.swap });
+                slots[hotbarSlot] = stack;
+                slots[source] = null;
+                hotbarSlot = null;
+            }
+            else
+            {
+                if (this.capacity(slots, to, stack) < stack.count) continue;
+                clicks.push({ slot: source, button: MOUSE_BUTTON.left, mode: CLICK_MODE.shift });
+                this.spread(slots, to, source);
+            }
+
+            remaining -= stack.count;
+        }
+
+        // Remainder: split the source stack that needs the fewest clicks
+        while (remaining > 0)
+        {
+            let best = null;
+            for (const source of sources)
+            {
+                const stack = slots[source];
+                if (!stack || stack.name !== name) continue;
+
+                const take = Math.min(remaining, stack.count);
+                const cost = TransferPlanner.splitCost(stack.count, take);
+                if (!best || cost < best.cost) best = { source, take, cost };
+            }
+
+            if (!best) break;
+
+            const destination = this.destinationFor(slots, to, slots[best.source], best.take);
+            if (destination === null) break;
+
+            this.planSplit(slots, best.source, destination, best.take, clicks);
+            remaining -= best.take;
+        }
+
+        return remaining;
+    }
+
+    /**
+     * @brief Appends the clicks moving part of a stack to a destination slot
+     * @param {Array} slots - Simulated window slots, updated in place
+     * @param {number} source - Source slot
+     * @param {number} destination - Destination slot (empty or same item)
+     * @param {number} take - Number of items to move
+     * @param {Array} clicks - Click list to append to
+     */
+    planSplit(slots, source, destination, take, clicks)
+    {
+        const stack = slots[source];
+        const count = stack.count;
+        const left = MOUSE_BUTTON.left, right = MOUSE_BUTTON.right, mode = CLICK_MODE.pickup;
+
+        if (take === count)
+        {
+            clicks.push({ slot: source, button: left, mode }, { slot: destination, button: left, mode });
+        }
+        else if (take === Math.ceil(count / 2))
+        {
+            // Right-click picks up the larger half
+            clicks.push({ slot: source, button: right, mode }, { slot: destination, button: left, mode });
+        }
+        else if (take <= count - take)
+        {
+            // Carry the stack, drop one item per right-click, put the rest back
+            clicks.push({ slot: source, button: left, mode });
+            for (let i = 0; i < take; i++) clicks.push({ slot: destination, button: right, mode });
+            clicks.push({ slot: source, button: left, mode });
+        }
+        else
+        {
+            // Carry the stack, return the excess one by one, drop the rest at once
+            clicks.push({ slot: source, button: left, mode });
+            for (let i = 0; i < count - take; i++) clicks.push({ slot: source, button: right, mode });
+            clicks.push({ slot: destination, button: left, mode });
+        }
+
+        if (slots[destination]) slots[destination].count += take;
+        else slots[destination] = { name: stack.name, count: take, stackSize: stack.stackSize };
+
+        stack.count -= take;
+        if (stack.count === 0) slots[source] = null;
+    }
+
+    /**
+     * @brief Simulates a shift-click, merging into existing stacks before empty slots
+     * @param {Array} slots - Simulated window slots, updated in place
+     * @param {Object} to - Destination range
+     * @param {number} source - Source slot
+     */
+    spread(slots, to, source)
+    {
+        const stack = slots[source];
+        let count = stack.count;
+
+        for (const slot of TransferPlanner.rangeSlots(to))
+        {
+            const target = slots[slot];
+            if (count === 0) break;
+            if (!target || target.name !== stack.name) continue;
+
+            const moved = Math.min(count, target.stackSize - target.count);
+            target.count += moved;
+            count -= moved;
+        }
+
+        for (const slot of TransferPlanner.rangeSlots(to))
+        {
+            if (count === 0) break;
+            if (slots[slot]) continue;
+
+            const moved = Math.min(count, stack.stackSize);
+            slots[slot] = { name: stack.name, count: moved, stackSize: stack.stackSize };
+            count -= moved;
+        }
+
+        slots[source] = null;
+    }
+
+    /**
+     * @brief Free room for an item in a slot range
+     * @param {Array} slots - Simulated window slots
+     * @param {Object} range - Slot range
+     * @param {Object} stack - Stack being moved
+     * @returns {number} Number of items the range can still accept
+     */
+    capacity(slots, range, stack)
+    {
+        let room = 0;
+        for (let slot = range.start; slot < range.end; slot++)
+        {
+            const target = slots[slot];
+            if (!target) room += stack.stackSize;
+            else if (target.name === stack.name) room += target.stackSize - target.count;
+        }
+        return room;
+    }
+
+    /**
+     * @brief Picks the slot receiving a partial stack, preferring a merge
+     * @param {Array} slots - Simulated window slots
+     * @param {Object} range - Destination range
+     * @param {Object} stack - Stack being split
+     * @param {number} take - Number of items to place
+     * @returns {number|null} Destination slot or null if nothing fits
+     */
+    destinationFor(slots, range, stack, take)
+    {
+        let empty = null;
+        for (const slot of TransferPlanner.rangeSlots(range))
+        {
+            const target = slots[slot];
+            if (!target)
+            {
+                if (empty === null) empty = slot;
+            }
+            else if (target.name === stack.name && target.stackSize - target.count >= take)
+            {
+                return slot;
+            }
+        }
+        return empty;
+    }
+
+    //* EXECUTION
+
+    /**
+     * @brief Sends a click sequence, keeping several clicks in flight when allowed
+     * @details The signal is checked before every click. On cancellation no further
+     *          click is sent and the clicks already in flight are allowed to settle
+     *          before the AbortError is thrown, so the caller can close the window safely.
+     * @param {Array} clicks - Clicks produced by plan()
+     * @param {number} depth - Maximum clicks awaiting the server (default: 8)
+     * @param {AbortSignal} signal - Cancellation signal (optional)
+     * @returns {Promise<number>} Number of clicks sent
+     * @throws {Error} AbortError when cancelled
+     */
+    async execute(clicks, depth = DEFAULT_PIPELINE_DEPTH, signal = null)
+    {
+        // Protocols with transaction confirmations reject unconfirmed follow-up clicks
+        if (this.bot.supportFeature('transactionPacketExists')) depth = 1;
+
+        const inFlight = [];
+        try
+        {
+            for (const click of clicks)
+            {
+                Abortable.check(signal);
+                inFlight.push(this.bot.clickWindow(click.slot, click.button, click.mode));
+                if (inFlight.length >= depth) await inFlight.shift();
+            }
+        }
+        catch (error)
+        {
+            await Promise.allSettled(inFlight);
+            throw error;
+        }
+
+        await Promise.all(inFlight);
+        return clicks.length;
+    }
+
+    //* HELPERS
+
+    /**
+     * @brief Number of clicks needed to move part of a stack
+     * @param {number} count - Size of the source stack
+     * @param {number} take - Number of items to move
+     * @returns {number} Click count
+     */
+    static splitCost(count, take)
+    {
+        if (take === count || take === Math.ceil(count / 2)) return 2;
+        return Math.min(take, count - take) + 2;
+    }
+
+    /**
+     * @brief Validates a requested hotbar index
+     * @param {number|undefined} index - Hotbar index 0-8
+     * @returns {number|null} The index, or null if none or out of range was requested
+     */
+    static hotbarIndex(index)
+    {
+        if (index === undefined || index < 0 || index > 8) return null;
+        return index;
+    }
+
+    /**
+     * @brief Iterates the slots of a range in fill order
+     * @param {Object} range - Slot range { start, end, reverse }
+     * @returns {Array<number>} Slots in the order they are filled
+     */
+    static rangeSlots(range)
+    {
+        const result = [];
+        for (let slot = range.start; slot < range.end; slot++) result.push(slot);
+        return range.reverse ? result.reverse() : result;
+    }
+}
+
+module.exports = TransferPlanner;
@@ -0,0 +1,302 @@
+/** *************************************************************************************
+
+    * @file        vitals.js
+    * @brief       Event driven health, hunger, oxygen and threat monitor with remedies
+    * @author      Agustín I. Galdeman
+    * @author      Ian A. Dib
+    * @author      Luciano S. Cordero
+    * @date        2025-07-24
+    * @version     1.0 - Initial vitals monitor module
+
+    ************************************************************************************* */
+
+
+/* **************************************************************************************
+    * INCLUDES AND DEPENDENCIES *
+   ************************************************************************************** */
+
+const EventEmitter = require('events');
+const Abortable = require('./abort');
+
+
+/* **************************************************************************************
+    * CONSTANTS AND STATIC DATA *
+   ************************************************************************************** */
+
+// Full health, food and oxygen values
+const MAX_VITAL = 20;
+
+// Oxygen level below which the bot abandons its task to reach the surface
+const CRITICAL_OXYGEN = 5;
+
+// Hostile mobs closer than this are threats; a hurt bot retreats from them
+const THREAT_RADIUS = 8;
+const RETREAT_HEALTH = 16;
+
+// Eating starts below HUNGER_THRESHOLD food points, or to regenerate below LOW_HEALTH
+const HUNGER_THRESHOLD = 14;
+const LOW_HEALTH = 10;
+
+// Remedy urgencies; eating grows from HUNGER_URGENCY to 1 as food runs out
+const SURFACE_URGENCY = 0.95;
+const RETREAT_URGENCY = 0.9;
+const REGEN_URGENCY = 0.8;
+const HUNGER_URGENCY = 0.55;
+
+// Time allowed to reach air before surfacing counts as failed, in milliseconds
+const SURFACE_TIMEOUT = 8000;
+const SURFACE_POLL = 250;
+
+// Steps taken away from a threat per retreat
+const RETREAT_STEPS = 6;
+
+// Retreats in a row that may fail to shake a threat before eating takes precedence
+const MAX_RETREATS = 3;
+
+// Deepest drop a retreat step may walk off, in blocks
+const MAX_RETREAT_DROP = 2;
+
+// Block offsets of the directions a retreat may take
+const STEP_OFFSETS =
+{
+    north: { x: 0, z: -1 },
+    south: { x: 0, z: 1 },
+    west: { x: -1, z: 0 },
+    east: { x: 1, z: 0 }
+};
+
+
+/* **************************************************************************************
+    * CLASS IMPLEMENTATIONS *
+   ************************************************************************************** */
+
+/**
+ * @class VitalsMonitor
+ * @brief Tracks the bot's vitals from game events and names the remedy it needs most
+ * @details Health, food, oxygen, inventory and nearby hostile mob events refresh a single
+ *          (remedy, urgency) pair; a 'change' event is emitted only when that pair changes,
+ *          so listeners react to a new need and never to routine packets. Remedies are
+ *          ordered by how fast the danger kills: surface, then retreat, then eat. A mob
+ *          that keeps up with the bot would hold it in retreat forever, so after
+ *          MAX_RETREATS retreats without losing the threat, eating ranks above retreat
+ *          until the threat is gone or the bot has eaten.
+ */
+class VitalsMonitor extends EventEmitter
+{
+    /**
+     * @brief Constructor subscribes to the events vitals depend on
+     * @param {Object} bot - Mineflayer bot instance
+     * @param {Object} actions - BotActions instance providing food, oxygen and movement
+     */
+    constructor(bot, actions)
+    {
+        super();
+        this.bot = bot;
+        this.actions = actions;
+        this.entities = actions.entities;
+
+        this.remedy = null;
+        this.urgency = 0;
+        this.threat = null;     // nearest hostile within THREAT_RADIUS
+        this.retreats = 0;      // retreats run since the threat appeared or the bot ate
+
+        this.onVitals = () => this.refresh();
+        this.onEntity = (entity) => this.handleEntity(entity);
+        this.onGone = (entity) => { if (entity === this.threat) this.handleEntity(entity); };
+
+        this.bot.on('health', this.onVitals);
+        this.bot.on('breath', this.onVitals);
+        this.bot.on('entitySpawn', this.onEntity);
+        this.bot.on('entityMoved', this.onEntity);
+        this.bot.on('entityGone', this.onGone);
+        if (actions.inventory) actions.inventory.on('change', this.onVitals);
+
+        this.refresh();
+    }
+
+    //* ASSESSMENT
+
+    /**
+     * @brief Recomputes the needed remedy, emitting 'change' if it differs
+     */
+    refresh()
+    {
+        const [remedy, urgency] = this.assess();
+        if (remedy === this.remedy && urgency === this.urgency) return;
+
+        this.remedy = remedy;
+        this.urgency = urgency;
+        this.emit('change', remedy, urgency);
+    }
+
+    /**
+     * @brief Picks the most urgent remedy for the current vitals
+     * @returns {Array} [remedy name or null, urgency from 0 to 1]
+     */
+    assess()
+    {
+        const health = this.bot.health ?? MAX_VITAL;
+        const food = this.bot.food ?? MAX_VITAL;
+
+        if (this.actions.oxygenLevel() < CRITICAL_OXYGEN) return ['surface', SURFACE_URGENCY];
+        if (this.threat && health < RETREAT_HEALTH && this.retreats < MAX_RETREATS) return ['retreat', RETREAT_URGENCY];
+
+        const hungry = food < HUNGER_THRESHOLD;
+        const regenerate = food < MAX_VITAL && health < LOW_HEALTH;
+        if ((!hungry && !regenerate) || !this.actions.bestFood()) return [null, 0];
+
+        if (!hungry) return ['eat', REGEN_URGENCY];
+        return ['eat', HUNGER_URGENCY + (1 - HUNGER_URGENCY) * (HUNGER_THRESHOLD - food) / HUNGER_THRESHOLD];
+    }
+
+    /**
+     * @brief Updates the tracked threat when a hostile mob moves near or away
+     * @details Only hostiles inside the radius, or the current threat, trigger a grid query.
+     * @param {Object} entity - Entity that spawned, moved or despawned
+     */
+    handleEntity(entity)
+    {
+        if (!VitalsMonitor.isHostile(entity) || !this.bot.entity) return;
+        if (entity !== this.threat && entity.position.distanceTo(this.bot.entity.position) > THREAT_RADIUS) return;
+
+        const previous = this.threat;
+        this.threat = this.entities ?
+            this.entities.nearest(this.bot.entity.position, THREAT_RADIUS, VitalsMonitor.isHostile) : null;
+        if (!this.threat) this.retreats = 0;
+
+        if (this.threat !== previous) this.refresh();
+    }
+
+    //* REMEDIES
+
+    /**
+     * @brief Eats the best food in the inventory
+     * @param {AbortSignal} signal - Cancellation signal (optional)
+     */
+    async eat(signal = null)
+    {
+        const food = this.actions.bestFood();
+        if (!food) return;
+
+        await this.actions.eat(food, { signal });
+        this.retreats = 0;
+    }
+
+    /**
+     * @brief Swims straight up until the bot breathes again
+     * @param {AbortSignal} signal - Cancellation signal (optional)
+     * @throws {Error} If air is not reached within the timeout, or AbortError when cancelled
+     */
+    async surface(signal = null)
+    {
+        const deadline = Date.now() + SURFACE_TIMEOUT;
+
+        try
+        {
+            this.bot.setControlState('jump', true);
+            while (this.actions.oxygenLevel() < MAX_VITAL)
+            {
+                if (Date.now() > deadline) throw new Error('Could not reach the surface');
+                await Abortable.sleep(SURFACE_POLL, signal);
+            }
+        }
+        finally
+        {
+            this.bot.setControlState('jump', false);
+        }
+    }
+
+    /**
+     * @brief Sprints away from the nearest threat along the cardinal axis leading away from it
+     * @details Each step goes along the axis leading away most, or the other axis if that
+     *          cell is blocked, a hazard or a long drop; with neither safe the retreat ends.
+     * @param {AbortSignal} signal - Cancellation signal (optional)
+     */
+    async retreat(signal = null)
+    {
+        this.retreats++;
+
+        for (let i = 0; i < RETREAT_STEPS && this.threat; i++)
+        {
+            const pos = this.bot.entity.position;
+            const dx = pos.x - this.threat.position.x;
+            const dz = pos.z - this.threat.position.z;
+            const alongX = dx >= 0 ? 'east' : 'west';
+            const alongZ = dz >= 0 ? 'south' : 'north';
+            const candidates = Math.abs(dx) >= Math.abs(dz) ? [alongX, alongZ] : [alongZ, alongX];
+
+            const direction = candidates.find(candidate => this.isSafeStep(candidate));
+            if (!direction) return;
+
+            await this.actions.step(direction, true, { signal });
+            this.handleEntity(this.threat);
+        }
+    }
+
+    /**
+     * @brief Checks that the cell one step away can be walked into and has a floor
+     * @param {string} direction - Cardinal direction
+     * @returns {boolean} True if feet and head are clear and solid ground lies within
+     *                    MAX_RETREAT_DROP blocks without a hazard on the way down
+     */
+    isSafeStep(direction)
+    {
+        const pos = this.actions.position();
+        const x = pos.x + STEP_OFFSETS[direction].x;
+        const z = pos.z + STEP_OFFSETS[direction].z;
+
+        for (const y of [pos.y, pos.y + 1])
+        {
+            const block = this.actions.block_at(x, y, z);
+            if (!block || !this.actions.isPassable(block)) return false;
+        }
+
+        for (let drop = 1; drop <= MAX_RETREAT_DROP + 1; drop++)
+        {
+            const block = this.actions.block_at(x, pos.y - drop, z);
+            if (!block || this.actions.isHazard(block)) return false;
+            if (!this.actions.isPassable(block)) return true;
+        }
+
+        return false;
+    }
+
+    //* LIFECYCLE
+
+    /**
+     * @brief Drops the threat of a lost connection and reassesses the new one
+     */
+    reattach()
+    {
+        this.threat = null;
+        this.retreats = 0;
+        this.refresh();
+    }
+
+    /**
+     * @brief Unsubscribes the monitor from every event
+     */
+    detach()
+    {
+        this.bot.removeListener('health', this.onVitals);
+        this.bot.removeListener('breath', this.onVitals);
+        this.bot.removeListener('entitySpawn', this.onEntity);
+        this.bot.removeListener('entityMoved', this.onEntity);
+        this.bot.removeListener('entityGone', this.onGone);
+        if (this.actions.inventory) this.actions.inventory.removeListener('change', this.onVitals);
+    }
+
+    //* HELPERS
+
+    /**
+     * @brief Checks whether an entity is a hostile mob
+     * @param {Object} entity - Entity
+     * @returns {boolean} True for hostile mobs
+     */
+    static isHostile(entity)
+    {
+        return entity.type === 'hostile';
+    }
+}
+
+module.exports = VitalsMonitor;